@@ -0,0 +1,417 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#ifndef O1CPPLIB_O1_HASH_BACKGROUND_TABLE_HH
+#define O1CPPLIB_O1_HASH_BACKGROUND_TABLE_HH
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "./o1.hash.table_t.hh"
+
+namespace o1 {
+
+	namespace hash {
+
+		/**
+		 * Hash table that resizes with the help of a background thread.
+		 *
+		 * On a plain table, the thread that makes the table cross a
+		 * sizing_strategy threshold allocates the new (zeroed) bucket
+		 * vector, and older slots are only migrated as their buckets get
+		 * touched.  Here a helper thread:
+		 * - allocates the bucket vector of the next (larger) slot before
+		 *   it is needed, when the table gets close to the threshold;
+		 * - sweeps older slots, moving one bucket at a time into the
+		 *   current slot, and releases them once empty.
+		 *
+		 * A bucket of an older slot being null is its migration state:
+		 * foreground operations keep moving the (single) bucket of the
+		 * key they work on, when it's still there, so they never move
+		 * more than one bucket per older slot, and they never wait for
+		 * the helper for longer than a single bucket move.
+		 *
+		 * All operations are serialized with a mutex held for the
+		 * duration of the operation; as the helper thread uses the table
+		 * on its own, entries must be removed through the table (not by
+		 * destroying them).
+		 */
+		template <
+			typename Key,
+			typename Value,
+			struct ops<Key, Value>* ops
+		>
+		class background_table: protected o1::hash::table<Key, Value, ops> {
+		public:
+
+			using table_t = o1::hash::table<Key, Value, ops>;
+
+			struct metrics_t {
+				/**
+				 * Bucket vectors allocated by the helper thread.
+				 */
+				size_t generationsPrepared{0};
+
+				/**
+				 * Buckets (and entries) moved by the helper thread.
+				 */
+				size_t bucketsMigrated{0};
+				size_t elementsMigrated{0};
+
+				/**
+				 * Entries moved by foreground operations.
+				 */
+				size_t foregroundElementsMigrated{0};
+
+				/**
+				 * Foreground operations that had to wait for the lock.
+				 */
+				size_t stalls{0};
+			};
+
+		private:
+
+			using buckets_t = typename table_t::buckets_t;
+
+			/**
+			 * Buckets the helper looks at (most of them may be null)
+			 * per lock acquisition.
+			 */
+			static const constexpr size_t scanLimit = 1024;
+
+			mutable std::mutex _mutex;
+			std::condition_variable _wakeup;
+			std::condition_variable _idled;
+			bool _stop{false};
+			bool _idle{false};
+
+			metrics_t _metrics;
+
+			/**
+			 * Older slot being swept, and next bucket index to move;
+			 * only valid while no slot got released by the foreground
+			 * (releasedSlots unchanged).
+			 */
+			buckets_t* _migrating{nullptr};
+			size_t _cursor{0};
+			size_t _releasedSlots{0};
+
+			std::thread _helper;
+
+			std::unique_lock<std::mutex> acquire() {
+				std::unique_lock<std::mutex> lock(_mutex, std::try_to_lock);
+				if (!lock.owns_lock()) {
+					lock.lock();
+					++_metrics.stalls;
+				}
+				return lock;
+			}
+
+			/**
+			 * @return the sizeIndex of the slot to be allocated ahead of
+			 *         time, 0 if there's none.
+			 * Must be called with the lock held.
+			 */
+			size_t nextSlot() const {
+				if (this->slots == nullptr)
+					return 0;
+
+				size_t next = this->currentSlot + 1;
+				auto& sizing = this->sizingStrategy;
+
+				if (next >= sizing.maxSizingIndex() || this->slots[next] != nullptr)
+					return 0;
+
+				if (table_t::size() <= sizing.maxElements(this->currentSlot) / 4 * 3)
+					return 0;
+
+				if (this->spare != nullptr && this->spare->numBuckets() == sizing.numBuckets(next))
+					return 0;
+
+				return next;
+			}
+
+			/**
+			 * Must be called with the lock held.
+			 */
+			bool migrating() const {
+				if (this->slots == nullptr)
+					return false;
+
+				for (size_t i = 0; i <= this->sizingStrategy.maxSizingIndex(); ++i) {
+					if (i != this->currentSlot && this->slots[i] != nullptr)
+						return true;
+				}
+
+				return false;
+			}
+
+			/**
+			 * Moves (at most) one bucket from an older slot.
+			 * Must be called with the lock held.
+			 * @param released set to the older slot, if it got emptied.
+			 * @return false if there was nothing to migrate.
+			 */
+			bool migrateStep(buckets_t*& released) {
+				if (this->slots == nullptr || this->slots[this->currentSlot] == nullptr)
+					return false;
+
+				for (size_t iSlot = 0; iSlot <= this->sizingStrategy.maxSizingIndex(); ++iSlot) {
+					auto buckets = this->slots[iSlot];
+
+					if (iSlot == this->currentSlot || buckets == nullptr)
+						continue;
+
+					if (
+						_migrating != buckets ||
+						_releasedSlots != this->releasedSlots ||
+						_cursor >= buckets->numBuckets()
+					) {
+						_migrating = buckets;
+						_releasedSlots = this->releasedSlots;
+						_cursor = 0;
+					}
+
+					size_t end = std::min(buckets->numBuckets(), _cursor + scanLimit);
+
+					while (_cursor < end) {
+						size_t index = _cursor++;
+						if (buckets->bucket(index) == nullptr)
+							continue;
+
+						size_t moved = buckets->rehashBucketInto(this->slots[this->currentSlot], index);
+						if (moved > 0) {
+							++_metrics.bucketsMigrated;
+							_metrics.elementsMigrated += moved;
+						}
+						break;
+					}
+
+					if (buckets->empty()) {
+						this->slots[iSlot] = nullptr;
+						_migrating = nullptr;
+						released = buckets;
+					}
+
+					return true;
+				}
+
+				return false;
+			}
+
+			/**
+			 * Wakes the helper up if it's idle and has something to do.
+			 * Must be called with the lock held.
+			 */
+			void notify() {
+				if (_idle && (nextSlot() != 0 || migrating()))
+					_wakeup.notify_one();
+			}
+
+			void run() {
+				std::unique_lock<std::mutex> lock(_mutex);
+
+				while (!_stop) {
+					if (size_t next = nextSlot()) {
+						size_t numBuckets = this->sizingStrategy.numBuckets(next);
+						buckets_t* stale = this->spare;
+						this->spare = nullptr;
+						lock.unlock();
+
+						delete stale;
+						auto spare = new buckets_t(numBuckets);
+						spare->reserve();
+
+						lock.lock();
+						if (this->spare == nullptr) {
+							this->spare = spare;
+							++_metrics.generationsPrepared;
+							spare = nullptr;
+						}
+
+						lock.unlock();
+						delete spare;
+						lock.lock();
+						continue;
+					}
+
+					buckets_t* released = nullptr;
+					if (migrateStep(released)) {
+						lock.unlock();
+						delete released;
+						std::this_thread::yield();
+						lock.lock();
+						continue;
+					}
+
+					_idle = true;
+					_idled.notify_all();
+					_wakeup.wait(lock);
+					_idle = false;
+				}
+			}
+
+		public:
+
+			background_table():
+				table_t(),
+				_helper(&background_table::run, this) {
+			}
+
+			/**
+			 * @param maxElements this is only a hint, to decide the maximum size
+			 *                    of the bucket vector.
+			 */
+			explicit background_table(size_t maxElements):
+				table_t(maxElements),
+				_helper(&background_table::run, this) {
+			}
+
+			background_table(const background_table& that) = delete;
+
+			background_table(background_table&& that) = delete;
+
+			~background_table() {
+				{
+					std::lock_guard<std::mutex> lock(_mutex);
+					_stop = true;
+					_wakeup.notify_one();
+				}
+				_helper.join();
+			}
+
+			metrics_t metrics() const {
+				std::lock_guard<std::mutex> lock(_mutex);
+				metrics_t ret = _metrics;
+				ret.foregroundElementsMigrated = this->rehashedElements;
+				return ret;
+			}
+
+			/**
+			 * @return true while there are older slots to be migrated.
+			 */
+			bool pending() const {
+				std::lock_guard<std::mutex> lock(_mutex);
+				return migrating();
+			}
+
+			/**
+			 * Blocks until the helper thread has nothing left to do: the
+			 * next slot (if due) is allocated, and older slots are
+			 * migrated.
+			 */
+			void wait_idle() {
+				std::unique_lock<std::mutex> lock(_mutex);
+				notify();
+				_idled.wait(lock, [this]() {
+					return _idle && nextSlot() == 0 && !migrating();
+				});
+			}
+
+			size_t size() const {
+				std::lock_guard<std::mutex> lock(_mutex);
+				return table_t::size();
+			}
+
+			bool empty() const {
+				std::lock_guard<std::mutex> lock(_mutex);
+				return table_t::empty();
+			}
+
+			bool insert(Value* value) {
+				auto lock = acquire();
+				auto retVal = table_t::insert(value);
+				notify();
+				return retVal;
+			}
+
+			bool set(Value* value, Value** old_value = nullptr) {
+				auto lock = acquire();
+				auto retVal = table_t::set(value, old_value);
+				notify();
+				return retVal;
+			}
+
+			bool replace(Value* value, Value** old_value = nullptr) {
+				auto lock = acquire();
+				return table_t::replace(value, old_value);
+			}
+
+			bool remove(Value* value, Value** old_value = nullptr) {
+				return remove(ops->getKey(value), old_value);
+			}
+
+			bool remove(const Key& key, Value** old_value = nullptr) {
+				auto lock = acquire();
+				auto retVal = table_t::remove(key, old_value);
+				notify();
+				return retVal;
+			}
+
+			template <typename Factory>
+			Value* find_or_insert(const Key& key, Factory factory, bool* inserted = nullptr) {
+				auto lock = acquire();
+				auto retVal = table_t::find_or_insert(key, factory, inserted);
+				notify();
+				return retVal;
+			}
+
+			template <typename Update, typename Factory>
+			Value* upsert(const Key& key, Update update, Factory factory) {
+				auto lock = acquire();
+				auto retVal = table_t::upsert(key, update, factory);
+				notify();
+				return retVal;
+			}
+
+			Value* find(const Key& key) {
+				auto lock = acquire();
+				return table_t::find(key);
+			}
+
+			/**
+			 * Remove all entries, NOT deleting them.
+			 */
+			void clear() {
+				auto lock = acquire();
+				table_t::clear();
+			}
+
+		};
+
+	}
+
+}
+
+#endif //O1CPPLIB_O1_HASH_BACKGROUND_TABLE_HH
@@ -0,0 +1,148 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "o1.hash.background_table.hh"
+#include "o1.hash.test_fixture.hh"
+
+namespace {
+
+	using namespace o1::hash::test;
+
+	using background_table = o1::hash::background_table<Key, Value, &_hash_ops>;
+
+	TEST(o1_hash_background_table, grow_and_shrink) {
+		background_table table;
+		const int count = 100000;
+		std::vector<HashNode*> nodes;
+
+		for (int i = 0; i < count; ++i) {
+			nodes.push_back(new HashNode(i));
+			EXPECT_TRUE(table.insert(nodes.back()));
+
+			// past 3/4 of the first threshold: the helper prepares the
+			// next generation before the foreground crosses it.
+			if (i == 25000) {
+				table.wait_idle();
+				EXPECT_GT(table.metrics().generationsPrepared, 0);
+			}
+		}
+
+		EXPECT_EQ(table.size(), count);
+
+		for (int i = 0; i < count; ++i)
+			ASSERT_EQ(table.find(i), nodes[i]) << "i=" << i;
+
+		table.wait_idle();
+		EXPECT_FALSE(table.pending());
+
+		auto metrics = table.metrics();
+		EXPECT_GT(metrics.generationsPrepared, 0);
+		EXPECT_GT(metrics.elementsMigrated, 0);
+
+		for (int i = 0; i < count - 10; ++i)
+			EXPECT_TRUE(table.remove(i));
+
+		EXPECT_EQ(table.size(), 10);
+
+		for (int i = count - 10; i < count; ++i)
+			EXPECT_EQ(table.find(i), nodes[i]) << "i=" << i;
+
+		table.wait_idle();
+		EXPECT_FALSE(table.pending());
+
+		table.clear();
+		EXPECT_TRUE(table.empty());
+
+		for (auto node: nodes)
+			delete node;
+	}
+
+	TEST(o1_hash_background_table, concurrent) {
+		background_table table;
+		const int numThreads = 4;
+		const int perThread = 20000;
+		std::vector<std::thread> threads;
+		std::vector<HashNode*> nodes(numThreads * perThread);
+
+		for (int t = 0; t < numThreads; ++t) {
+			threads.emplace_back([&table, &nodes, t]() {
+				for (int i = t * perThread; i < (t + 1) * perThread; ++i) {
+					nodes[i] = new HashNode(i);
+					table.insert(nodes[i]);
+					EXPECT_EQ(table.find(i), nodes[i]);
+				}
+			});
+		}
+
+		for (auto& thread: threads)
+			thread.join();
+
+		EXPECT_EQ(table.size(), nodes.size());
+
+		for (size_t i = 0; i < nodes.size(); ++i)
+			ASSERT_EQ(table.find(i), nodes[i]) << "i=" << i;
+
+		table.clear();
+
+		for (auto node: nodes)
+			delete node;
+	}
+
+	TEST(o1_hash_background_table, upsert) {
+		background_table table;
+		int updates = 0;
+
+		for (int i = 0; i < 100; ++i) {
+			table.upsert(i % 10, [&updates](HashNode*) { ++updates; }, [i]() { return new HashNode(i % 10); });
+		}
+
+		EXPECT_EQ(table.size(), 10);
+		EXPECT_EQ(updates, 90);
+
+		bool inserted = true;
+		auto node = table.find_or_insert(3, []() -> HashNode* { return nullptr; }, &inserted);
+		EXPECT_FALSE(inserted);
+
+		for (int i = 0; i < 10; ++i) {
+			HashNode* old_value = nullptr;
+			EXPECT_TRUE(table.remove(i, &old_value));
+			EXPECT_TRUE(i != 3 || old_value == node);
+			delete old_value;
+		}
+	}
+
+}
@@ -35,7 +35,9 @@
 #ifndef O1CPPLIB_O1_HASH_BUCKET_T_HH
 #define O1CPPLIB_O1_HASH_BUCKET_T_HH
 
+#include "../../o1.logging.hh"
 #include "./o1.hash.ops_t.hh"
+#include "../iterator/o1.prefetch_iterator.hh"
 
 namespace o1 {
 
@@ -81,7 +83,18 @@ namespace o1 {
 
 			bucket_t(bucket_t&& that) = delete;
 
-			~bucket_t() = default;
+			/**
+			 * Remaining entries are detached (NOT deleted).
+			 */
+			~bucket_t() {
+				while (nodes.pop_front());
+			}
+
+			/**
+			 * Sets up the chain list ahead of time, so that inserting
+			 * does not allocate memory.
+			 */
+			void reserve() { nodes.reserve(); }
 
 			bool empty() { return nodes.empty(); }
 
@@ -92,8 +105,8 @@ namespace o1 {
 				Value* value
 			) {
 
-				for (auto i: nodes) {
-					if (ops->equal(key, ops->getKey(i)))
+				for (auto& i: nodes) {
+					if (ops->equal(key, ops->getKey(&i)))
 						return false;
 				}
 
@@ -117,11 +130,11 @@ namespace o1 {
 
 				bool replaced = false;
 
-				for (auto i: nodes) {
-					if (ops->equal(key, ops->getKey(*i))) {
+				for (auto& i: nodes) {
+					if (ops->equal(key, ops->getKey(&i))) {
 						if (old_value != nullptr)
-							*old_value = *i;
-						ops->getNode(*i).detach(); // TODO "embedded" flag
+							*old_value = &i;
+						getBucketNode(&i)->detach(); // TODO "embedded" flag
 						replaced = true;
 						break;
 					}
@@ -134,17 +147,17 @@ namespace o1 {
 
 			bool replace(
 				const Key& key,
-				Value value,
-				Value* old_value
+				Value* value,
+				Value** old_value
 			) {
 				if (old_value != nullptr)
 					*old_value = nullptr;
 
-				for (auto i: nodes) {
-					if (ops->equal(key, ops->getKey(*i))) {
+				for (auto& i: nodes) {
+					if (ops->equal(key, ops->getKey(&i))) {
 						if (old_value != nullptr)
-							*old_value = *i;
-						ops->getNode(*i).detach(); // TODO "embedded" flag
+							*old_value = &i;
+						getBucketNode(&i)->detach(); // TODO "embedded" flag
 						nodes.push_back(value);
 						return true;
 					}
@@ -160,11 +173,11 @@ namespace o1 {
 				if (old_value != nullptr)
 					*old_value = nullptr;
 
-				for (auto i: nodes) {
-					if (ops->equal(key, ops->getKey(i))) {
+				for (auto& i: nodes) {
+					if (ops->equal(key, ops->getKey(&i))) {
 						if (old_value != nullptr)
-							*old_value = i;
-						getBucketNode(i)->detach(); // TODO "embedded" flag
+							*old_value = &i;
+						getBucketNode(&i)->detach(); // TODO "embedded" flag
 						return true;
 					}
 				}
@@ -172,10 +185,52 @@ namespace o1 {
 				return false;
 			}
 
+			/**
+			 * Nodes prefetched ahead by forEach().
+			 */
+			static const constexpr size_t prefetchDistance = 2;
+
+			/**
+			 * Calls @param fn(Value*) on each entry of the bucket.
+			 * @param fn may detach the entry it got, but no other one.
+			 */
+			template <typename Fn>
+			void forEach(Fn fn) {
+				o1::for_each_prefetch(nodes, prefetchDistance, fn);
+			}
+
+			/**
+			 * Looks @param key up, walking the chain once; on a miss, the
+			 * entry returned by @param factory() is appended (unless it's a
+			 * nullptr).
+			 * @param inserted set to whether the entry was created.
+			 * @return the entry found or created.
+			 */
+			template <typename Factory>
+			Value* findOrInsert(const Key& key, Factory& factory, bool& inserted) {
+				inserted = false;
+
+				for (auto& i: nodes) {
+					if (ops->equal(key, ops->getKey(&i)))
+						return &i;
+				}
+
+				Value* value = factory();
+				if (value == nullptr)
+					return nullptr;
+
+				o1::xassert(ops->equal(key, ops->getKey(value)),
+					"o1::hash: find_or_insert factory created an entry with another key");
+
+				nodes.push_back(value);
+				inserted = true;
+				return value;
+			}
+
 			Value* find(const Key& key) {
-				for (auto i: nodes) {
-					if (ops->equal(key, ops->getKey(i))) {
-						return i;
+				for (auto& i: nodes) {
+					if (ops->equal(key, ops->getKey(&i))) {
+						return &i;
 					}
 				}
 				return nullptr;
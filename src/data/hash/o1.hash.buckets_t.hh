@@ -66,6 +66,12 @@ namespace o1 {
 			 */
 			size_t nonNullBucketsCount{0};
 
+			/**
+			 * Set by preallocate(): buckets are not released when they
+			 * get empty.
+			 */
+			bool keepBuckets{false};
+
 		protected:
 
 			typedef enum {
@@ -75,7 +81,7 @@ namespace o1 {
 			} GetBucketOptions;
 
 			void deleteIfEmpty(bucket_t<Key,Value,ops>** bucket) {
-				if ((*bucket)->empty()) {
+				if (!keepBuckets && (*bucket)->empty()) {
 					delete *bucket;
 					*bucket = nullptr;
 					--nonNullBucketsCount;
@@ -141,6 +147,19 @@ namespace o1 {
 
 			bool empty() const { return nonNullBucketsCount == 0;}
 
+			/**
+			 * Length of the buckets array.
+			 */
+			inline size_t numBuckets() const { return bucketsCount; }
+
+			/**
+			 * @return the bucket at @param index, or nullptr if there's
+			 *         none (no allocation is done).
+			 */
+			inline bucket_t<Key,Value,ops>* bucket(size_t index) {
+				return buckets == nullptr ? nullptr : buckets[index];
+			}
+
 			bool insert(
 				const Key& key,
 				hash_val hashValue,
@@ -150,6 +169,33 @@ namespace o1 {
 					->insert(key, value);
 			}
 
+			/**
+			 * Bulk loading support: inserts into the bucket at @param index
+			 * (which must be the one of the key) w/out updating the number
+			 * of non-null buckets, so that different threads can insert
+			 * into different buckets at the same time, once reserve() got
+			 * called.
+			 * @param allocated incremented if the bucket got allocated; the
+			 *        sum must be passed to addNonNullBuckets() afterwards.
+			 */
+			bool insertAt(
+				size_t index,
+				const Key& key,
+				Value* value,
+				size_t& allocated
+			) {
+				auto bucket = &buckets[index];
+				if (*bucket == nullptr) {
+					*bucket = new bucket_t<Key, Value, ops>();
+					++allocated;
+				}
+				return (*bucket)->insert(key, value);
+			}
+
+			void addNonNullBuckets(size_t count) {
+				nonNullBucketsCount += count;
+			}
+
 			/**
 			 * Returns true if the entry was added and not replaced.
 			 * @param key
@@ -194,6 +240,20 @@ namespace o1 {
 				return bucket->remove(key, old_value);
 			}
 
+			template <typename Factory>
+			Value* findOrInsert(
+				const Key& key,
+				hash_val hashValue,
+				Factory& factory,
+				bool& inserted
+			) {
+				auto bucket = getBucket(hashValue, gboAlloc);
+				auto value = bucket->findOrInsert(key, factory, inserted);
+				if (value == nullptr)
+					deleteIfEmpty(&buckets[hashValue % bucketsCount]);
+				return value;
+			}
+
 			Value* find(const Key& key, hash_val hashValue) {
 				auto bucket = getBucket(hashValue, gboDeleteIfEmpty);
 
@@ -203,22 +263,86 @@ namespace o1 {
 				return bucket->find(key);
 			}
 
-			void rehashInto(buckets_t<Key,Value,ops>* that, hash_val hashValue) {
-				auto bucket = getBucket(hashValue, gboDeleteIfEmpty);
+			/**
+			 * Like find(), but w/out deleting empty buckets, so it does
+			 * not modify this object.
+			 */
+			Value* peek(const Key& key, hash_val hashValue) {
+				auto bucket = getBucket(hashValue);
 
-				if (bucket == nullptr)
-					return;
+				if (!bucket)
+					return nullptr;
+
+				return bucket->find(key);
+			}
+
+			/**
+			 * Prefetches the bucket pointer of @param hashValue.
+			 */
+			inline void prefetch(hash_val hashValue) const {
+				if (buckets != nullptr)
+					__builtin_prefetch(&buckets[hashValue % bucketsCount]);
+			}
+
+			/**
+			 * Allocates the buckets array (if not done yet), so that
+			 * inserting does not have to.
+			 */
+			void reserve() {
+				if (buckets == nullptr)
+					buckets = new bucket_t<Key, Value, ops>* [bucketsCount]{nullptr};
+			}
+
+			/**
+			 * Allocates the buckets array and every bucket, and keeps them
+			 * until this object is destroyed, so that no operation
+			 * allocates (nor releases) memory from then on.
+			 */
+			void preallocate() {
+				reserve();
+				for (size_t i = 0; i < bucketsCount; ++i) {
+					if (buckets[i] == nullptr) {
+						buckets[i] = new bucket_t<Key, Value, ops>();
+						++nonNullBucketsCount;
+					}
+					buckets[i]->reserve();
+				}
+				keepBuckets = true;
+			}
+
+			/**
+			 * Moves the entries of the bucket of @param hashValue into
+			 * @param that.
+			 * @return number of entries moved.
+			 */
+			size_t rehashInto(buckets_t<Key,Value,ops>* that, hash_val hashValue) {
+				return rehashBucketInto(that, hashValue % bucketsCount);
+			}
+
+			/**
+			 * Moves the entries of the bucket at @param index into
+			 * @param that, releasing the bucket.
+			 * @return number of entries moved.
+			 */
+			size_t rehashBucketInto(buckets_t<Key,Value,ops>* that, size_t index) {
+				if (buckets == nullptr || buckets[index] == nullptr)
+					return 0;
+
+				auto bucket = buckets[index];
+				size_t moved = 0;
 
 				while (auto _value = bucket->shift()) {
 					auto _key = ops->getKey(_value);
 					auto _hashValue = ops->hashValue(_key);
 					auto inserted = that->insert(_key, _hashValue, _value);
 					o1::xassert(inserted, "o1::hash::buckets_t::rehashInto found a duplicate entry");
+					++moved;
 				}
 
 				delete bucket;
-				buckets[hashValue % bucketsCount] = nullptr;
+				buckets[index] = nullptr;
 				--nonNullBucketsCount;
+				return moved;
 			}
 
 		};
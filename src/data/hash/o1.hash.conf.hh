@@ -38,4 +38,10 @@
 #define O1_HASH_TABLE_DEFAULT_MAX_BUCKET_SIZES_COUNT 16
 #define O1_HASH_TABLE_DEFAULT_LOAD_EXPONENT 3
 
+/**
+ * Tables holding up to this many entries keep no bucket vectors (0
+ * disables it), see o1::hash::table.
+ */
+#define O1_HASH_TABLE_SMALL_SIZE 8
+
 #endif //O1CPPLIB_O1_HASH_CONF_HH
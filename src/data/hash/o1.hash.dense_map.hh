@@ -0,0 +1,307 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#ifndef O1CPPLIB_O1_HASH_DENSE_MAP_HH
+#define O1CPPLIB_O1_HASH_DENSE_MAP_HH
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "../../o1.logging.hh"
+#include "./o1.hash.ops_t.hh"
+
+namespace o1 {
+
+	namespace hash {
+
+		/**
+		 * Hashing ops for non intrusive containers (the keys are stored
+		 * by the container).
+		 */
+		template <typename Key>
+		struct key_ops {
+			typedef hash_val hashFn(const Key&);
+			hashFn* hashValue;
+
+			typedef bool equalFn(const Key& left, const Key& right);
+			equalFn* equal;
+		};
+
+		/**
+		 * Hash map storing its entries in a contiguous vector, so that
+		 * iterating it streams through memory.
+		 *
+		 * Lookups go through a separate open addressing index (linear
+		 * probing) of (hash value, entry position) pairs, so most of the
+		 * probes that don't match never touch the entries.
+		 *
+		 * Removal is O(1): the last entry is moved into the hole, so the
+		 * order of entries is not preserved, and pointers to entries (and
+		 * iterators) are invalidated by insertions and removals.
+		 */
+		template <
+			typename Key,
+			typename T,
+			struct key_ops<Key>* ops
+		>
+		class dense_map {
+		public:
+
+			struct entry {
+				Key key;
+				T value;
+			};
+
+			using iterator = typename std::vector<entry>::iterator;
+			using const_iterator = typename std::vector<entry>::const_iterator;
+
+		private:
+
+			struct slot {
+				hash_val hash;
+				uint32_t position;
+			};
+
+			static const constexpr uint32_t emptySlot = UINT32_MAX;
+
+			static const constexpr size_t minSlots = 8;
+
+			std::vector<entry> _entries;
+			std::vector<slot> _index;
+			size_t _mask{0};
+
+			inline size_t home(hash_val hashValue) const {
+				// hash values may be weak in the low bits.
+				return (static_cast<uint64_t>(hashValue) * 0x9e3779b97f4a7c15ULL >> 32) & _mask;
+			}
+
+			/**
+			 * @return the index slot of @param key, or the empty slot where
+			 *         it would be placed.
+			 */
+			size_t lookup(const Key& key, hash_val hashValue) const {
+				size_t i = home(hashValue);
+				while (true) {
+					const slot& s = _index[i];
+					if (s.position == emptySlot)
+						return i;
+					if (s.hash == hashValue && ops->equal(_entries[s.position].key, key))
+						return i;
+					i = (i + 1) & _mask;
+				}
+			}
+
+			/**
+			 * @return the index slot pointing to entry @param position.
+			 */
+			size_t slotOf(size_t position) const {
+				hash_val hashValue = ops->hashValue(_entries[position].key);
+				size_t i = home(hashValue);
+				while (_index[i].position != position)
+					i = (i + 1) & _mask;
+				return i;
+			}
+
+			void rebuild(size_t numSlots) {
+				_index.assign(numSlots, slot{0, emptySlot});
+				_mask = numSlots - 1;
+
+				for (size_t position = 0; position < _entries.size(); ++position) {
+					hash_val hashValue = ops->hashValue(_entries[position].key);
+					size_t i = home(hashValue);
+					while (_index[i].position != emptySlot)
+						i = (i + 1) & _mask;
+					_index[i] = slot{hashValue, static_cast<uint32_t>(position)};
+				}
+			}
+
+			/**
+			 * Keeps the index at most 3/4 full.
+			 */
+			void grow() {
+				if (4 * (_entries.size() + 1) <= 3 * _index.size())
+					return;
+
+				o1::xassert(_entries.size() < emptySlot, "o1::hash::dense_map: too many entries");
+				rebuild(_index.empty() ? minSlots : 2 * _index.size());
+			}
+
+			/**
+			 * Backward shift deletion of index slot @param i.
+			 */
+			void erase(size_t i) {
+				size_t j = i;
+				while (true) {
+					j = (j + 1) & _mask;
+					if (_index[j].position == emptySlot)
+						break;
+
+					// move j into the hole, unless its home lies in (i, j].
+					size_t k = home(_index[j].hash);
+					bool stays = i <= j ? (i < k && k <= j) : (i < k || k <= j);
+					if (stays)
+						continue;
+
+					_index[i] = _index[j];
+					i = j;
+				}
+				_index[i].position = emptySlot;
+			}
+
+		public:
+
+			dense_map() = default;
+
+			size_t size() const { return _entries.size(); }
+
+			bool empty() const { return _entries.empty(); }
+
+			/**
+			 * Makes room for @param count entries.
+			 */
+			void reserve(size_t count) {
+				_entries.reserve(count);
+				size_t numSlots = minSlots;
+				while (3 * numSlots < 4 * count)
+					numSlots *= 2;
+				if (numSlots > _index.size())
+					rebuild(numSlots);
+			}
+
+			T* find(const Key& key) {
+				if (_entries.empty())
+					return nullptr;
+				const slot& s = _index[lookup(key, ops->hashValue(key))];
+				return s.position == emptySlot ? nullptr : &_entries[s.position].value;
+			}
+
+			const T* find(const Key& key) const {
+				return const_cast<dense_map*>(this)->find(key);
+			}
+
+			/**
+			 * Adds the @param key entry, if it's not present.
+			 * @return true if it was added.
+			 */
+			bool insert(const Key& key, T value) {
+				grow();
+				hash_val hashValue = ops->hashValue(key);
+				size_t i = lookup(key, hashValue);
+				if (_index[i].position != emptySlot)
+					return false;
+
+				_index[i] = slot{hashValue, static_cast<uint32_t>(_entries.size())};
+				_entries.push_back(entry{key, std::move(value)});
+				return true;
+			}
+
+			/**
+			 * @return the value of @param key, adding a default constructed
+			 *         one if it was not present.
+			 */
+			T& operator [] (const Key& key) {
+				grow();
+				hash_val hashValue = ops->hashValue(key);
+				size_t i = lookup(key, hashValue);
+				if (_index[i].position == emptySlot) {
+					_index[i] = slot{hashValue, static_cast<uint32_t>(_entries.size())};
+					_entries.push_back(entry{key, T()});
+				}
+				return _entries[_index[i].position].value;
+			}
+
+			/**
+			 * Removes the @param key entry, moving the last entry in its
+			 * place.
+			 * @param old_value if not a nullptr, the removed value is moved
+			 *        here.
+			 * @return true if the entry was found.
+			 */
+			bool remove(const Key& key, T* old_value = nullptr) {
+				if (_entries.empty())
+					return false;
+
+				size_t i = lookup(key, ops->hashValue(key));
+				if (_index[i].position == emptySlot)
+					return false;
+
+				size_t position = _index[i].position;
+				size_t last = _entries.size() - 1;
+
+				if (old_value != nullptr)
+					*old_value = std::move(_entries[position].value);
+
+				erase(i);
+
+				if (position != last) {
+					_index[slotOf(last)].position = static_cast<uint32_t>(position);
+					_entries[position] = std::move(_entries[last]);
+				}
+
+				_entries.pop_back();
+				return true;
+			}
+
+			void clear() {
+				_entries.clear();
+				_index.clear();
+				_mask = 0;
+			}
+
+			iterator begin() { return _entries.begin(); }
+
+			iterator end() { return _entries.end(); }
+
+			const_iterator begin() const { return _entries.begin(); }
+
+			const_iterator end() const { return _entries.end(); }
+
+			/**
+			 * @return the entries, contiguous in memory.
+			 */
+			const entry* data() const { return _entries.data(); }
+
+		};
+
+		template <typename Key, typename T, struct key_ops<Key>* ops>
+		const constexpr uint32_t dense_map<Key, T, ops>::emptySlot;
+
+		template <typename Key, typename T, struct key_ops<Key>* ops>
+		const constexpr size_t dense_map<Key, T, ops>::minSlots;
+
+	}
+
+}
+
+#endif //O1CPPLIB_O1_HASH_DENSE_MAP_HH
@@ -0,0 +1,139 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#include <gtest/gtest.h>
+#include <map>
+#include <random>
+#include <string>
+#include "o1.hash.dense_map.hh"
+
+namespace {
+
+	o1::hash::hash_val hashFn(const int& key) {
+		return o1::hash::hashValue(&key, sizeof(key), 0);
+	}
+
+	bool equalFn(const int& left, const int& right) {
+		return left == right;
+	}
+
+	o1::hash::key_ops<int> _key_ops{
+		.hashValue = hashFn,
+		.equal = equalFn
+	};
+
+	using dense_map = o1::hash::dense_map<int, std::string, &_key_ops>;
+
+	TEST(o1_hash_dense_map, basic_tests) {
+		dense_map map;
+
+		EXPECT_EQ(map.find(1), nullptr);
+		EXPECT_FALSE(map.remove(1));
+
+		EXPECT_TRUE(map.insert(1, "one"));
+		EXPECT_FALSE(map.insert(1, "uno"));
+		EXPECT_TRUE(map.insert(2, "two"));
+		map[3] = "three";
+
+		ASSERT_NE(map.find(1), nullptr);
+		EXPECT_EQ(*map.find(1), "one");
+		EXPECT_EQ(map[2], "two");
+		EXPECT_EQ(map.size(), 3);
+
+		std::string old_value;
+		EXPECT_TRUE(map.remove(1, &old_value));
+		EXPECT_EQ(old_value, "one");
+		EXPECT_EQ(map.find(1), nullptr);
+		EXPECT_EQ(*map.find(3), "three");
+		EXPECT_EQ(map.size(), 2);
+
+		// entries are contiguous.
+		EXPECT_EQ(&*map.begin(), map.data());
+		EXPECT_EQ(map.end() - map.begin(), 2);
+
+		map.clear();
+		EXPECT_TRUE(map.empty());
+		EXPECT_EQ(map.find(3), nullptr);
+	}
+
+	TEST(o1_hash_dense_map, against_std_map) {
+		dense_map map;
+		std::map<int, std::string> reference;
+		std::mt19937 random(1);
+
+		for (int i = 0; i < 200000; ++i) {
+			int key = random() % 5000;
+			switch (random() % 3) {
+				case 0:
+					EXPECT_EQ(map.insert(key, std::to_string(i)), reference.emplace(key, std::to_string(i)).second);
+					break;
+				case 1:
+					EXPECT_EQ(map.remove(key), reference.erase(key) == 1);
+					break;
+				default: {
+					auto found = map.find(key);
+					auto expected = reference.find(key);
+					ASSERT_EQ(found != nullptr, expected != reference.end()) << "key=" << key;
+					if (found != nullptr) {
+						EXPECT_EQ(*found, expected->second);
+					}
+				}
+			}
+		}
+
+		EXPECT_EQ(map.size(), reference.size());
+
+		size_t visited = 0;
+		for (auto& entry: map) {
+			EXPECT_EQ(entry.value, reference[entry.key]);
+			++visited;
+		}
+		EXPECT_EQ(visited, reference.size());
+	}
+
+	TEST(o1_hash_dense_map, reserve) {
+		dense_map map;
+		map.reserve(1000);
+		auto data = map.data();
+
+		for (int i = 0; i < 1000; ++i)
+			map.insert(i, std::to_string(i));
+
+		EXPECT_EQ(map.data(), data);
+
+		for (int i = 0; i < 1000; ++i)
+			ASSERT_EQ(*map.find(i), std::to_string(i));
+	}
+
+}
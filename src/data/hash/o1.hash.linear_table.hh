@@ -0,0 +1,407 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#ifndef O1CPPLIB_O1_HASH_LINEAR_TABLE_HH
+#define O1CPPLIB_O1_HASH_LINEAR_TABLE_HH
+
+#include <cstdint>
+#include <vector>
+#include "../../o1.logging.hh"
+#include "./o1.hash.ops_t.hh"
+#include "./o1.hash.bucket_t.hh"
+#include "./o1.hash.conf.hh"
+
+namespace o1 {
+
+	namespace hash {
+
+		/**
+		 * Hash table using linear hashing: it grows (and shrinks) one
+		 * bucket at a time, splitting (merging) the bucket at the split
+		 * pointer, so there are neither large allocations nor several
+		 * generations of buckets to probe.
+		 *
+		 * With n0 = initialBuckets, after "level" full rounds of splits
+		 * and "split" splits in the current round there are
+		 * n0 * 2^level + split buckets, and the bucket of a hash value h is
+		 * h mod n0 * 2^level, or h mod n0 * 2^(level+1) if the former is
+		 * below split (that bucket has already been split in this round).
+		 *
+		 * Buckets are kept in a segmented directory: fixed size arrays of
+		 * segmentSize bucket pointers, allocated (and released) as the
+		 * table grows (and shrinks), so the largest allocation ever done
+		 * is one segment (plus the vector of segments itself).
+		 *
+		 * As hash values are 32 bits wide, the table stops splitting at
+		 * 2^32 buckets.
+		 */
+		template <
+			typename Key,
+			typename Value,
+			struct ops<Key, Value>* ops
+		>
+		class linear_table {
+		public:
+
+			using bucket_t = o1::hash::bucket_t<Key, Value, ops>;
+
+			static const constexpr size_t initialBuckets =
+				static_cast<size_t>(1) << O1_HASH_TABLE_DEFAULT_LOAD_EXPONENT;
+
+			static const constexpr size_t segmentSize = 512;
+
+		private:
+
+			static o1::d_linked::node_t<Value>*
+			getElementsNode(Value* obj) {
+				return ops->getElementsNode(obj);
+			}
+
+			o1::hash::list_t<Value> _elements;
+
+			std::vector<bucket_t**> _segments;
+
+			/**
+			 * n0 * 2^level - 1.
+			 */
+			size_t _lowMask{initialBuckets - 1};
+
+			/**
+			 * Next bucket to be split.
+			 */
+			size_t _split{0};
+
+			size_t _maxLoadFactor;
+
+			inline bucket_t*& slot(size_t index) {
+				return _segments[index / segmentSize][index % segmentSize];
+			}
+
+			inline bucket_t* slot(size_t index) const {
+				return _segments[index / segmentSize][index % segmentSize];
+			}
+
+			inline size_t address(hash_val hashValue) const {
+				size_t index = hashValue & _lowMask;
+				if (index < _split)
+					index = hashValue & ((_lowMask << 1) | 1);
+				return index;
+			}
+
+			bucket_t* getBucket(hash_val hashValue, bool alloc) {
+				auto& bucket = slot(address(hashValue));
+				if (bucket == nullptr && alloc)
+					bucket = new bucket_t();
+				return bucket;
+			}
+
+			void deleteIfEmpty(hash_val hashValue) {
+				auto& bucket = slot(address(hashValue));
+				if (bucket != nullptr && bucket->empty()) {
+					delete bucket;
+					bucket = nullptr;
+				}
+			}
+
+			/**
+			 * Moves the entries of bucket @param from that belong in bucket
+			 * @param to (given the current address() function).
+			 */
+			void move(size_t from, size_t to) {
+				auto& source = slot(from);
+				if (source == nullptr)
+					return;
+
+				auto& target = slot(to);
+
+				source->forEach([this, &target, to](Value* value) {
+					auto key = ops->getKey(value);
+					if (address(ops->hashValue(key)) != to)
+						return;
+
+					ops->getBucketNode(value)->detach();
+
+					if (target == nullptr)
+						target = new bucket_t();
+
+					auto inserted = target->insert(key, value);
+					o1::xassert(inserted, "o1::hash::linear_table: duplicate entry while moving");
+				});
+
+				if (source->empty()) {
+					delete source;
+					source = nullptr;
+				}
+			}
+
+			/**
+			 * Adds one bucket, splitting the one at the split pointer.
+			 */
+			void split() {
+				if (_lowMask >= UINT32_MAX)
+					return;
+
+				size_t index = _lowMask + 1 + _split;
+
+				if (index / segmentSize == _segments.size())
+					_segments.push_back(new bucket_t*[segmentSize]{nullptr});
+
+				size_t from = _split;
+
+				if (++_split > _lowMask) {
+					_lowMask = (_lowMask << 1) | 1;
+					_split = 0;
+				}
+
+				move(from, index);
+			}
+
+			/**
+			 * Removes the last bucket, merging it into its buddy.
+			 */
+			void merge() {
+				if (_split == 0) {
+					if (_lowMask + 1 == initialBuckets)
+						return;
+					_lowMask >>= 1;
+					_split = _lowMask + 1;
+				}
+
+				--_split;
+				size_t last = _lowMask + 1 + _split;
+
+				move(last, _split);
+
+				if (last % segmentSize == 0) {
+					delete[] _segments.back();
+					_segments.pop_back();
+				}
+			}
+
+			void grow() {
+				if (_elements.size() > numBuckets() * _maxLoadFactor)
+					split();
+			}
+
+			void shrink() {
+				if (numBuckets() > initialBuckets && _elements.size() * 4 < numBuckets() * _maxLoadFactor)
+					merge();
+			}
+
+		public:
+
+			/**
+			 * @param maxLoadFactor a bucket is added each time the average
+			 *        number of entries per bucket goes above this value (and
+			 *        removed when it goes below a fourth of it).
+			 */
+			explicit linear_table(size_t maxLoadFactor = 1):
+				_elements(getElementsNode),
+				_maxLoadFactor(maxLoadFactor == 0 ? 1 : maxLoadFactor) {
+				_segments.push_back(new bucket_t*[segmentSize]{nullptr});
+			}
+
+			linear_table(const linear_table& that) = delete;
+
+			linear_table(linear_table&& that) = delete;
+
+			~linear_table() {
+				clear();
+				delete[] _segments.front();
+			}
+
+			size_t size() const { return _elements.size(); }
+
+			bool empty() const { return _elements.empty(); }
+
+			/**
+			 * @return current number of buckets.
+			 */
+			inline size_t numBuckets() const { return _lowMask + 1 + _split; }
+
+			bool insert(Value* value) {
+				auto key = ops->getKey(value);
+				auto retVal = getBucket(ops->hashValue(key), true)->insert(key, value);
+				if (retVal) {
+					_elements.push_back(value);
+					grow();
+				}
+				return retVal;
+			}
+
+			/**
+			 * Inserts or updates the key=ops->getKey(value) entry with the
+			 * passed value.
+			 * @param value
+			 * @param old_value if !nullptr, existing value (if any) is stored here.
+			 * @return true if the entry was not found and added.
+			 */
+			bool set(Value* value, Value** old_value = nullptr) {
+				Value* _old_value = nullptr;
+				auto key = ops->getKey(value);
+				auto retVal = getBucket(ops->hashValue(key), true)->set(key, value, &_old_value);
+				if (_old_value != nullptr)
+					ops->getElementsNode(_old_value)->detach();
+				_elements.push_back(value);
+				if (old_value != nullptr)
+					*old_value = _old_value;
+				if (retVal)
+					grow();
+				return retVal;
+			}
+
+			/**
+			 * Stores the passed value only if it was already present.
+			 * @return true if the entry was found and replaced.
+			 */
+			bool replace(Value* value, Value** old_value = nullptr) {
+				Value* _old_value = nullptr;
+				auto key = ops->getKey(value);
+				auto bucket = getBucket(ops->hashValue(key), false);
+				if (bucket == nullptr || !bucket->replace(key, value, &_old_value))
+					return false;
+
+				ops->getElementsNode(_old_value)->detach();
+				_elements.push_back(value);
+				if (old_value != nullptr)
+					*old_value = _old_value;
+				return true;
+			}
+
+			bool remove(Value* value, Value** old_value = nullptr) {
+				return remove(ops->getKey(value), old_value);
+			}
+
+			bool remove(const Key& key, Value** old_value = nullptr) {
+				Value* _old_value = nullptr;
+				hash_val hashValue = ops->hashValue(key);
+				auto bucket = getBucket(hashValue, false);
+				if (bucket == nullptr)
+					return false;
+
+				auto retVal = bucket->remove(key, &_old_value);
+				if (retVal) {
+					ops->getElementsNode(_old_value)->detach();
+					if (old_value != nullptr)
+						*old_value = _old_value;
+				}
+
+				deleteIfEmpty(hashValue);
+				shrink();
+				return retVal;
+			}
+
+			/**
+			 * Looks @param key up and, if it's missing, inserts the entry
+			 * created by @param factory() (see table::find_or_insert()).
+			 */
+			template <typename Factory>
+			Value* find_or_insert(const Key& key, Factory factory, bool* inserted = nullptr) {
+				bool _inserted = false;
+				hash_val hashValue = ops->hashValue(key);
+				auto retVal = getBucket(hashValue, true)->findOrInsert(key, factory, _inserted);
+				if (_inserted) {
+					_elements.push_back(retVal);
+					grow();
+				} else if (retVal == nullptr) {
+					deleteIfEmpty(hashValue);
+				}
+				if (inserted != nullptr)
+					*inserted = _inserted;
+				return retVal;
+			}
+
+			/**
+			 * Calls @param update(Value*) on the entry of @param key, or
+			 * inserts the one created by @param factory() if there is none,
+			 * with a single lookup (see find_or_insert()).
+			 * @return the entry updated or created.
+			 */
+			template <typename Update, typename Factory>
+			Value* upsert(const Key& key, Update update, Factory factory) {
+				bool inserted = false;
+				auto retVal = find_or_insert(key, factory, &inserted);
+				if (retVal != nullptr && !inserted)
+					update(retVal);
+				return retVal;
+			}
+
+			Value* find(const Key& key) {
+				auto bucket = getBucket(ops->hashValue(key), false);
+				return bucket == nullptr ? nullptr : bucket->find(key);
+			}
+
+			Value* peek(const Key& key) const {
+				auto bucket = slot(address(ops->hashValue(key)));
+				return bucket == nullptr ? nullptr : bucket->find(key);
+			}
+
+			/**
+			 * Remove all entries, NOT deleting them.
+			 */
+			void clear() {
+				while (_elements.pop_front());
+
+				for (size_t i = 0; i < numBuckets(); ++i) {
+					delete slot(i);
+					slot(i) = nullptr;
+				}
+
+				while (_segments.size() > 1) {
+					delete[] _segments.back();
+					_segments.pop_back();
+				}
+
+				_lowMask = initialBuckets - 1;
+				_split = 0;
+			}
+
+			const o1::hash::list_t<Value>&
+			elements() {
+				return _elements;
+			}
+
+		};
+
+		template <typename Key, typename Value, struct ops<Key, Value>* ops>
+		const constexpr size_t linear_table<Key, Value, ops>::initialBuckets;
+
+		template <typename Key, typename Value, struct ops<Key, Value>* ops>
+		const constexpr size_t linear_table<Key, Value, ops>::segmentSize;
+
+	}
+
+}
+
+#endif //O1CPPLIB_O1_HASH_LINEAR_TABLE_HH
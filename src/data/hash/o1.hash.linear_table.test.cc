@@ -0,0 +1,153 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#include <gtest/gtest.h>
+#include <vector>
+#include "o1.hash.linear_table.hh"
+#include "o1.hash.test_fixture.hh"
+namespace {
+
+	using namespace o1::hash::test;
+
+	using linear_table = o1::hash::linear_table<Key, Value, &_hash_ops>;
+
+	TEST(o1_hash_linear_table, basic_tests) {
+		linear_table table;
+
+		HashNode node{1};
+		EXPECT_TRUE(table.insert(&node));
+		EXPECT_FALSE(table.insert(&node));
+		EXPECT_EQ(table.find(1), &node);
+		EXPECT_EQ(table.peek(1), &node);
+		EXPECT_TRUE(table.remove(&node));
+		EXPECT_EQ(table.find(1), nullptr);
+		EXPECT_FALSE(table.remove(1));
+		EXPECT_TRUE(table.empty());
+	}
+
+	TEST(o1_hash_linear_table, grows_one_bucket_at_a_time) {
+		linear_table table;
+		const int count = 20000;
+		std::vector<HashNode*> nodes;
+
+		for (int i = 0; i < count; ++i) {
+			size_t numBuckets = table.numBuckets();
+			nodes.push_back(new HashNode(i));
+			EXPECT_TRUE(table.insert(nodes.back()));
+			EXPECT_LE(table.numBuckets(), numBuckets + 1);
+			EXPECT_LE(table.size(), table.numBuckets());
+		}
+
+		EXPECT_EQ(table.size(), count);
+		EXPECT_EQ(table.numBuckets(), count);
+
+		for (int i = 0; i < count; ++i)
+			ASSERT_EQ(table.find(i), nodes[i]) << "i=" << i;
+
+		for (int i = 0; i < count - 100; ++i) {
+			size_t numBuckets = table.numBuckets();
+			EXPECT_TRUE(table.remove(i));
+			EXPECT_GE(table.numBuckets() + 1, numBuckets);
+		}
+
+		// one bucket merged per removal, once below a fourth of the load factor.
+		EXPECT_EQ(table.numBuckets(), count - (count / 4 - 100));
+
+		for (int i = 0; i < count - 100; ++i)
+			EXPECT_EQ(table.find(i), nullptr) << "i=" << i;
+
+		for (int i = count - 100; i < count; ++i)
+			EXPECT_EQ(table.find(i), nodes[i]) << "i=" << i;
+
+		for (auto node: nodes)
+			delete node;
+
+		EXPECT_TRUE(table.empty());
+	}
+
+	TEST(o1_hash_linear_table, set_and_replace) {
+		linear_table table(4);
+		HashNode a{1}, b{1}, c{1}, d{2};
+		HashNode* old_value = nullptr;
+
+		EXPECT_TRUE(table.set(&a, &old_value));
+		EXPECT_EQ(old_value, nullptr);
+		EXPECT_FALSE(table.set(&b, &old_value));
+		EXPECT_EQ(old_value, &a);
+		EXPECT_TRUE(table.replace(&c, &old_value));
+		EXPECT_EQ(old_value, &b);
+		EXPECT_FALSE(table.replace(&d));
+		EXPECT_EQ(table.find(1), &c);
+		EXPECT_EQ(table.size(), 1);
+	}
+
+	TEST(o1_hash_linear_table, clear) {
+		linear_table table;
+		std::vector<HashNode*> nodes;
+
+		for (int i = 0; i < 5000; ++i) {
+			nodes.push_back(new HashNode(i));
+			table.insert(nodes.back());
+		}
+
+		table.clear();
+		EXPECT_TRUE(table.empty());
+		EXPECT_EQ(table.numBuckets(), linear_table::initialBuckets);
+		EXPECT_EQ(table.find(10), nullptr);
+
+		for (auto node: nodes)
+			delete node;
+	}
+
+	TEST(o1_hash_linear_table, find_or_insert) {
+		linear_table table;
+		std::vector<HashNode*> nodes;
+
+		for (int i = 0; i < 3000; ++i) {
+			bool inserted = false;
+			auto node = table.find_or_insert(i % 1000, [&nodes, i]() {
+				nodes.push_back(new HashNode(i % 1000));
+				return nodes.back();
+			}, &inserted);
+			EXPECT_EQ(inserted, i < 1000);
+			EXPECT_EQ(node, nodes[i % 1000]);
+		}
+
+		EXPECT_EQ(table.size(), 1000);
+
+		for (auto node: nodes)
+			delete node;
+	}
+
+}
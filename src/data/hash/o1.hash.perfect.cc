@@ -0,0 +1,449 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#include "o1.hash.perfect.hh"
+#include "o1.hash.parallel.hh"
+#include "../../errors/o1.error.errno.hh"
+#include "../../errors/o1.error.invalid-format.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using o1::hash::perfect;
+
+namespace {
+
+	const uint64_t magic = 0x31306668706d316fULL; // "o1mphf01"
+
+	/**
+	 * Seeds tried on each partition before giving up.
+	 */
+	const uint32_t maxSeeds = 256;
+
+	const size_t valuesAlignment = 64;
+
+	inline size_t alignUp(size_t x, size_t alignment) {
+		return (x + alignment - 1) & ~(alignment - 1);
+	}
+
+	class file {
+		int _fd;
+	public:
+		file(const char* path, int flags, mode_t mode = 0): _fd(open(path, flags, mode)) {
+			if (_fd < 0)
+				throw o1::errors::Errno();
+		}
+
+		file(const file& that) = delete;
+
+		~file() { close(_fd); }
+
+		inline int fd() const { return _fd; }
+
+		void write(const void* buf, size_t length) {
+			auto p = reinterpret_cast<const char*>(buf);
+			while (length > 0) {
+				ssize_t written = ::write(_fd, p, length);
+				if (written < 0) {
+					if (errno == EINTR)
+						continue;
+					throw o1::errors::Errno();
+				}
+				p += written;
+				length -= written;
+			}
+		}
+
+		void pad(size_t length) {
+			static const char zeroes[valuesAlignment] = {};
+			while (length > 0) {
+				size_t chunk = std::min(length, sizeof(zeroes));
+				write(zeroes, chunk);
+				length -= chunk;
+			}
+		}
+	};
+
+}
+
+perfect::perfect(perfect&& that) noexcept {
+	*this = std::move(that);
+}
+
+perfect& perfect::operator = (perfect&& that) noexcept {
+	if (this == &that)
+		return *this;
+
+	release();
+
+	_size = that._size;
+	_numPartitions = that._numPartitions;
+	_numBuckets = that._numBuckets;
+	_valueSize = that._valueSize;
+	_values = that._values;
+	_map = that._map;
+	_mapLength = that._mapLength;
+	_partitionsStorage = std::move(that._partitionsStorage);
+	_pilotsStorage = std::move(that._pilotsStorage);
+
+	if (_map != nullptr) {
+		_partitions = that._partitions;
+		_pilots = that._pilots;
+	} else {
+		_partitions = _partitionsStorage.data();
+		_pilots = _pilotsStorage.data();
+	}
+
+	that._map = nullptr;
+	that.release();
+	return *this;
+}
+
+perfect::~perfect() {
+	release();
+}
+
+void perfect::release() {
+	if (_map != nullptr)
+		munmap(_map, _mapLength);
+
+	_map = nullptr;
+	_mapLength = 0;
+	_size = 0;
+	_numPartitions = 0;
+	_numBuckets = 0;
+	_partitions = nullptr;
+	_pilots = nullptr;
+	_values = nullptr;
+	_valueSize = 0;
+	_partitionsStorage.clear();
+	_pilotsStorage.clear();
+}
+
+uint64_t perfect::fingerprint(const void* buf, size_t length) {
+	// FNV-1a, with a final mix so that all of the bits get used.
+	uint64_t result = 0xcbf29ce484222325ULL ^ length;
+	auto p = reinterpret_cast<const uint8_t*>(buf);
+
+	for (size_t i = 0; i < length; ++i) {
+		result ^= p[i];
+		result *= 0x100000001b3ULL;
+	}
+
+	return mix(result);
+}
+
+bool perfect::solve(const uint64_t* keys, partition& p, uint16_t* pilots) const {
+	const uint64_t numKeys = p.numKeys;
+	if (numKeys == 0)
+		return true;
+
+	std::vector<uint64_t> sorted(keys, keys + numKeys);
+	std::sort(sorted.begin(), sorted.end());
+	if (std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end())
+		return false;
+
+	// group the keys by bucket (counting sort).
+	const uint64_t numBuckets = bucketsFor(numKeys);
+	std::vector<uint32_t> start(numBuckets + 1, 0);
+	std::vector<uint64_t> bucketKeys(numKeys);
+
+	for (uint64_t i = 0; i < numKeys; ++i)
+		++start[bucketOf(keys[i], numBuckets) + 1];
+
+	size_t maxBucketSize = 0;
+	for (uint64_t b = 0; b < numBuckets; ++b) {
+		maxBucketSize = std::max<size_t>(maxBucketSize, start[b + 1]);
+		start[b + 1] += start[b];
+	}
+
+	{
+		std::vector<uint32_t> cursor(start.begin(), start.end() - 1);
+		for (uint64_t i = 0; i < numKeys; ++i)
+			bucketKeys[cursor[bucketOf(keys[i], numBuckets)]++] = keys[i];
+	}
+
+	// place the largest buckets first.
+	std::vector<uint32_t> order(numBuckets);
+	for (uint64_t b = 0; b < numBuckets; ++b)
+		order[b] = b;
+
+	std::stable_sort(order.begin(), order.end(), [&start](uint32_t left, uint32_t right) {
+		return start[left + 1] - start[left] > start[right + 1] - start[right];
+	});
+
+	std::vector<uint8_t> taken(numKeys);
+	std::vector<uint64_t> slots(maxBucketSize);
+
+	for (uint32_t seed = 0; seed < maxSeeds; ++seed) {
+		std::fill(taken.begin(), taken.end(), 0);
+		bool solved = true;
+
+		for (auto b: order) {
+			const uint32_t first = start[b];
+			const uint32_t size = start[b + 1] - first;
+			bool placed = (size == 0);
+			uint32_t pilot = 0;
+
+			for (; !placed && pilot <= UINT16_MAX; ++pilot) {
+				uint32_t i = 0;
+				for (; i < size; ++i) {
+					uint64_t slot = slotOf(bucketKeys[first + i], seed, pilot, numKeys);
+					if (taken[slot])
+						break;
+					taken[slot] = 1;
+					slots[i] = slot;
+				}
+
+				if (i == size) {
+					placed = true;
+					break;
+				}
+
+				while (i-- > 0)
+					taken[slots[i]] = 0;
+			}
+
+			if (!placed) {
+				solved = false;
+				break;
+			}
+
+			pilots[b] = size == 0 ? 0 : pilot;
+		}
+
+		if (solved) {
+			p.seed = seed;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool perfect::build(const uint64_t* fingerprints, size_t count, unsigned numThreads) {
+	release();
+
+	const uint64_t numPartitions = std::max<uint64_t>(1, (count + partitionSize - 1) / partitionSize);
+
+	if (numThreads == 0)
+		numThreads = std::max(1u, std::thread::hardware_concurrency());
+	numThreads = std::min<uint64_t>(numThreads, std::max<uint64_t>(1, count / partitionSize));
+
+	// hash, and count the keys of each partition (per thread).
+	std::vector<uint64_t> hashes(count);
+	std::vector<std::vector<uint64_t>> counts(numThreads, std::vector<uint64_t>(numPartitions, 0));
+
+	auto rangeOf = [count, numThreads](unsigned t, size_t& first, size_t& last) {
+		first = count * t / numThreads;
+		last = count * (t + 1) / numThreads;
+	};
+
+	o1::hash::parallel(numThreads, [&](unsigned t) {
+		size_t first, last;
+		rangeOf(t, first, last);
+		auto& threadCounts = counts[t];
+		for (size_t i = first; i < last; ++i) {
+			hashes[i] = mix(fingerprints[i]);
+			++threadCounts[fastrange(hashes[i], numPartitions)];
+		}
+	});
+
+	// partition descriptors, and where each thread scatters its keys.
+	std::vector<partition> partitions(numPartitions);
+	uint64_t keyOffset = 0;
+	uint64_t bucketOffset = 0;
+
+	for (uint64_t i = 0; i < numPartitions; ++i) {
+		uint64_t numKeys = 0;
+		for (unsigned t = 0; t < numThreads; ++t) {
+			uint64_t threadCount = counts[t][i];
+			counts[t][i] = keyOffset + numKeys;
+			numKeys += threadCount;
+		}
+
+		if (numKeys > UINT32_MAX)
+			return false;
+
+		partitions[i] = partition{keyOffset, bucketOffset, static_cast<uint32_t>(numKeys), 0};
+		keyOffset += numKeys;
+		bucketOffset += bucketsFor(numKeys);
+	}
+
+	std::vector<uint64_t> partitioned(count);
+
+	o1::hash::parallel(numThreads, [&](unsigned t) {
+		size_t first, last;
+		rangeOf(t, first, last);
+		auto& cursor = counts[t];
+		for (size_t i = first; i < last; ++i)
+			partitioned[cursor[fastrange(hashes[i], numPartitions)]++] = hashes[i];
+	});
+
+	std::vector<uint64_t>().swap(hashes);
+
+	// solve the partitions.
+	std::vector<uint16_t> pilots(bucketOffset);
+	std::atomic<uint64_t> next{0};
+	std::atomic<bool> failed{false};
+
+	o1::hash::parallel(numThreads, [&](unsigned) {
+		for (uint64_t i = next++; i < numPartitions && !failed; i = next++) {
+			partition& p = partitions[i];
+			if (!solve(&partitioned[p.keyOffset], p, &pilots[p.bucketOffset]))
+				failed = true;
+		}
+	});
+
+	if (failed)
+		return false;
+
+	_size = count;
+	_numPartitions = numPartitions;
+	_numBuckets = bucketOffset;
+	_partitionsStorage = std::move(partitions);
+	_pilotsStorage = std::move(pilots);
+	_partitions = _partitionsStorage.data();
+	_pilots = _pilotsStorage.data();
+	return true;
+}
+
+size_t perfect::bytes() const {
+	return
+		sizeof(header) +
+		_numPartitions * sizeof(partition) +
+		_numBuckets * sizeof(uint16_t);
+}
+
+void perfect::save(const char* path, const void* values, size_t valueSize) const {
+	const size_t pilotsOffset = sizeof(header) + _numPartitions * sizeof(partition);
+	const size_t pilotsEnd = pilotsOffset + _numBuckets * sizeof(uint16_t);
+	if (valueSize == 0)
+		values = nullptr;
+
+	const size_t valuesOffset = values == nullptr ? 0 : alignUp(pilotsEnd, valuesAlignment);
+
+	header h{magic, _size, _numPartitions, _numBuckets, values == nullptr ? 0 : valueSize, valuesOffset};
+
+	file f(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	f.write(&h, sizeof(h));
+	f.write(_partitions, _numPartitions * sizeof(partition));
+	f.write(_pilots, _numBuckets * sizeof(uint16_t));
+
+	if (values != nullptr) {
+		f.pad(valuesOffset - pilotsEnd);
+		f.write(values, _size * valueSize);
+	}
+}
+
+void perfect::load(const char* path) {
+	release();
+
+	file f(path, O_RDONLY);
+	struct stat st;
+	if (fstat(f.fd(), &st) != 0)
+		throw o1::errors::Errno();
+
+	const size_t length = st.st_size;
+	if (length < sizeof(header))
+		throw o1::errors::InvalidFormat("o1::hash::perfect file", path);
+
+	void* map = mmap(nullptr, length, PROT_READ, MAP_SHARED, f.fd(), 0);
+	if (map == MAP_FAILED)
+		throw o1::errors::Errno();
+
+	auto base = reinterpret_cast<const char*>(map);
+	auto h = reinterpret_cast<const header*>(base);
+
+	const size_t pilotsOffset = sizeof(header) + h->numPartitions * sizeof(partition);
+	const size_t pilotsEnd = pilotsOffset + h->numBuckets * sizeof(uint16_t);
+
+	bool valid =
+		h->magic == magic &&
+		h->numPartitions > 0 &&
+		h->numPartitions <= length / sizeof(partition) &&
+		h->numBuckets <= length / sizeof(uint16_t) &&
+		pilotsEnd <= length &&
+		(h->valuesOffset == 0 || (
+			h->valuesOffset >= pilotsEnd &&
+			h->valuesOffset <= length &&
+			h->valuesOffset % valuesAlignment == 0 &&
+			h->valueSize != 0 &&
+			h->size <= (length - h->valuesOffset) / h->valueSize));
+
+	if (valid) {
+		// partitions must be contiguous and within bounds, or index()
+		// would read pilots (and values) past their arrays.
+		auto partitions = reinterpret_cast<const partition*>(base + sizeof(header));
+		uint64_t keyOffset = 0;
+		uint64_t bucketOffset = 0;
+
+		for (uint64_t i = 0; valid && i < h->numPartitions; ++i) {
+			auto& p = partitions[i];
+			const uint64_t numBuckets = bucketsFor(p.numKeys);
+			valid =
+				p.keyOffset == keyOffset &&
+				p.bucketOffset == bucketOffset &&
+				p.numKeys <= h->size - keyOffset &&
+				numBuckets <= h->numBuckets - bucketOffset;
+			keyOffset += p.numKeys;
+			bucketOffset += numBuckets;
+		}
+
+		valid = valid &&
+			keyOffset == h->size &&
+			bucketOffset == h->numBuckets;
+	}
+
+	if (!valid) {
+		munmap(map, length);
+		throw o1::errors::InvalidFormat("o1::hash::perfect file", path);
+	}
+
+	_map = map;
+	_mapLength = length;
+	_size = h->size;
+	_numPartitions = h->numPartitions;
+	_numBuckets = h->numBuckets;
+	_partitions = reinterpret_cast<const partition*>(base + sizeof(header));
+	_pilots = reinterpret_cast<const uint16_t*>(base + pilotsOffset);
+	_values = h->valuesOffset == 0 ? nullptr : base + h->valuesOffset;
+	_valueSize = h->valueSize;
+}
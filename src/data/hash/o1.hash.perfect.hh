@@ -0,0 +1,259 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#ifndef O1CPPLIB_O1_HASH_PERFECT_HH
+#define O1CPPLIB_O1_HASH_PERFECT_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "../../o1.logging.hh"
+
+namespace o1 {
+
+	namespace hash {
+
+		/**
+		 * Minimal perfect hash function over a static set of 64 bit
+		 * fingerprints.
+		 *
+		 * index() maps each of the n fingerprints the function was built
+		 * with to a distinct slot in [0, n), so values can be kept in a
+		 * dense array with no keys, pointers or chains: a lookup is a
+		 * single access into that array. Fingerprints not in the set
+		 * map to an arbitrary slot, so callers that may look up unknown
+		 * keys should store (and check) the fingerprint with the value.
+		 *
+		 * The construction is CHD / PTHash style: keys are split into
+		 * partitions of about partitionSize keys; each partition splits its
+		 * keys into buckets (of lambda keys on average) and stores one 16
+		 * bit displacement ("pilot") per bucket, chosen so that all of the
+		 * bucket keys land in free slots. That's 16 / lambda ~ 3.2 bits per
+		 * key, plus a 24 byte descriptor per partition.
+		 *
+		 * Partitions are independent, so they get built in parallel.
+		 *
+		 * The function (and, optionally, a dense value array) can be saved
+		 * to a file that gets mmap()ed by load(): no parsing nor copying is
+		 * done on load. The file uses the host byte order.
+		 */
+		class perfect {
+		public:
+
+			/**
+			 * Average number of keys per bucket.
+			 */
+			static const constexpr unsigned lambda = 5;
+
+			/**
+			 * Average number of keys per partition.
+			 */
+			static const constexpr unsigned partitionSize = 2048;
+
+			/**
+			 * On disk partition descriptor.
+			 */
+			struct partition {
+				uint64_t keyOffset;
+				uint64_t bucketOffset;
+				uint32_t numKeys;
+				uint32_t seed;
+			};
+
+			/**
+			 * On disk header.
+			 */
+			struct header {
+				uint64_t magic;
+				uint64_t size;
+				uint64_t numPartitions;
+				uint64_t numBuckets;
+				uint64_t valueSize;
+				uint64_t valuesOffset;
+			};
+
+		private:
+
+			uint64_t _size{0};
+			uint64_t _numPartitions{0};
+			uint64_t _numBuckets{0};
+			const partition* _partitions{nullptr};
+			const uint16_t* _pilots{nullptr};
+			const void* _values{nullptr};
+			uint64_t _valueSize{0};
+
+			std::vector<partition> _partitionsStorage;
+			std::vector<uint16_t> _pilotsStorage;
+
+			void* _map{nullptr};
+			size_t _mapLength{0};
+
+			static inline uint64_t mix(uint64_t x) {
+				x ^= x >> 30;
+				x *= 0xbf58476d1ce4e5b9ULL;
+				x ^= x >> 27;
+				x *= 0x94d049bb133111ebULL;
+				x ^= x >> 31;
+				return x;
+			}
+
+			/**
+			 * @return x scaled into [0, n).
+			 */
+			static inline uint64_t fastrange(uint64_t x, uint64_t n) {
+				return static_cast<uint64_t>((static_cast<unsigned __int128>(x) * n) >> 64);
+			}
+
+			/**
+			 * Skewed bucket assignment: 60% of the keys go to 30% of the
+			 * buckets, so that large buckets (placed first, while most of
+			 * the slots are free) take most of the keys.
+			 */
+			static inline uint64_t bucketOf(uint64_t h, uint64_t numBuckets) {
+				const uint64_t x = (h << 32) | (h >> 32);
+				const uint64_t threshold = 0x9999999999999999ULL; // 0.6 * 2^64
+				const uint64_t dense = numBuckets * 3 / 10;
+
+				if (dense == 0)
+					return fastrange(x, numBuckets);
+
+				return x < threshold ?
+					fastrange(x / 3 * 5, dense) :
+					dense + fastrange((x - threshold) / 2 * 5, numBuckets - dense);
+			}
+
+			static inline uint64_t slotOf(uint64_t h, uint32_t seed, uint16_t pilot, uint64_t numKeys) {
+				return fastrange(mix(h ^ mix((static_cast<uint64_t>(seed) << 16) + pilot + 1)), numKeys);
+			}
+
+			static inline uint64_t bucketsFor(uint64_t numKeys) {
+				return numKeys == 0 ? 0 : (numKeys + lambda - 1) / lambda;
+			}
+
+			bool solve(const uint64_t* keys, partition& p, uint16_t* pilots) const;
+
+			void release();
+
+		public:
+
+			perfect() = default;
+
+			perfect(const perfect& that) = delete;
+
+			perfect(perfect&& that) noexcept;
+
+			perfect& operator = (perfect&& that) noexcept;
+
+			~perfect();
+
+			/**
+			 * @return a 64 bit fingerprint of a key, suitable for build()
+			 *         and index().
+			 */
+			static uint64_t fingerprint(const void* buf, size_t length);
+
+			/**
+			 * Builds the function, replacing any previous one.
+			 * @param fingerprints the key set; it's only used during the build.
+			 * @param count number of fingerprints.
+			 * @param numThreads threads to use, 0 for one per hardware thread.
+			 * @return false if the fingerprints are not unique (or the
+			 *         function could not be built).
+			 */
+			bool build(const uint64_t* fingerprints, size_t count, unsigned numThreads = 0);
+
+			/**
+			 * @return the slot of fingerprint, in [0, size()); size() must
+			 *         not be 0.
+			 */
+			inline uint64_t index(uint64_t fingerprint) const {
+				const uint64_t h = mix(fingerprint);
+				const partition& p = _partitions[fastrange(h, _numPartitions)];
+				const uint64_t numBuckets = bucketsFor(p.numKeys);
+				const uint16_t pilot = _pilots[p.bucketOffset + bucketOf(h, numBuckets)];
+				return p.keyOffset + slotOf(h, p.seed, pilot, p.numKeys);
+			}
+
+			/**
+			 * @return number of keys (and slots).
+			 */
+			inline uint64_t size() const { return _size; }
+
+			/**
+			 * @return bytes used by the function itself (not counting values).
+			 */
+			size_t bytes() const;
+
+			/**
+			 * @return the value array saved along with the function (or
+			 *         nullptr if there is none), indexed by index().
+			 */
+			inline const void* values() const { return _values; }
+
+			inline uint64_t valueSize() const { return _valueSize; }
+
+			/**
+			 * @return the value of @param fingerprint; T must be
+			 *         valueSize() bytes long.
+			 */
+			template <typename T>
+			inline const T& value(uint64_t fingerprint) const {
+				o1::xassert(sizeof(T) == _valueSize,
+					"o1::hash::perfect::value: values are %zu bytes long, not %zu",
+					size_t(_valueSize), sizeof(T));
+				return reinterpret_cast<const T*>(_values)[index(fingerprint)];
+			}
+
+			/**
+			 * Writes the function into path.
+			 * @param values optional dense value array (size() items of
+			 *        valueSize bytes each), indexed by index().
+			 * @throws o1::errors::Errno on I/O errors.
+			 */
+			void save(const char* path, const void* values = nullptr, size_t valueSize = 0) const;
+
+			/**
+			 * Maps a file written by save(), replacing any previous function.
+			 * @throws o1::errors::Errno on I/O errors.
+			 * @throws o1::errors::InvalidFormat if path was not written by save().
+			 */
+			void load(const char* path);
+
+		};
+
+	}
+
+}
+
+#endif //O1CPPLIB_O1_HASH_PERFECT_HH
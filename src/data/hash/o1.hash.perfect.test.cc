@@ -0,0 +1,240 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <random>
+#include <unistd.h>
+#include <vector>
+#include "o1.hash.perfect.hh"
+#include "../../errors/o1.error.invalid-format.hh"
+
+namespace {
+
+	std::vector<uint64_t> randomFingerprints(size_t count, uint64_t seed) {
+		std::mt19937_64 random(seed);
+		std::vector<uint64_t> ret(count);
+		for (auto& fingerprint: ret)
+			fingerprint = random();
+		return ret;
+	}
+
+	void expectMinimalPerfect(const o1::hash::perfect& mphf, const std::vector<uint64_t>& keys) {
+		ASSERT_EQ(mphf.size(), keys.size());
+		std::vector<bool> seen(keys.size(), false);
+
+		for (auto key: keys) {
+			auto slot = mphf.index(key);
+			ASSERT_LT(slot, keys.size());
+			ASSERT_FALSE(seen[slot]) << "collision on slot " << slot;
+			seen[slot] = true;
+		}
+	}
+
+	std::string tempPath() {
+		char path[] = "/tmp/o1.hash.perfect.test.XXXXXX";
+		int fd = mkstemp(path);
+		close(fd);
+		return path;
+	}
+
+	TEST(o1_hash_perfect, small_sets) {
+		for (size_t count = 1; count < 64; ++count) {
+			auto keys = randomFingerprints(count, count);
+			o1::hash::perfect mphf;
+			ASSERT_TRUE(mphf.build(keys.data(), keys.size(), 1));
+			expectMinimalPerfect(mphf, keys);
+		}
+	}
+
+	TEST(o1_hash_perfect, parallel_build) {
+		auto keys = randomFingerprints(300000, 42);
+
+		o1::hash::perfect mphf;
+		ASSERT_TRUE(mphf.build(keys.data(), keys.size(), 4));
+		expectMinimalPerfect(mphf, keys);
+
+		// ~ 16 / lambda bits per key, plus the partition descriptors.
+		EXPECT_LT(8.0 * mphf.bytes() / keys.size(), 3.5);
+
+		// the result does not depend on the number of threads.
+		o1::hash::perfect single;
+		ASSERT_TRUE(single.build(keys.data(), keys.size(), 1));
+		for (size_t i = 0; i < keys.size(); i += 97)
+			EXPECT_EQ(single.index(keys[i]), mphf.index(keys[i]));
+	}
+
+	TEST(o1_hash_perfect, duplicates) {
+		auto keys = randomFingerprints(5000, 7);
+		keys.push_back(keys[1234]);
+
+		o1::hash::perfect mphf;
+		EXPECT_FALSE(mphf.build(keys.data(), keys.size(), 2));
+		EXPECT_EQ(mphf.size(), 0);
+	}
+
+	TEST(o1_hash_perfect, fingerprint) {
+		std::vector<uint64_t> keys;
+		for (int i = 0; i < 10000; ++i) {
+			auto s = "key-" + std::to_string(i);
+			keys.push_back(o1::hash::perfect::fingerprint(s.data(), s.length()));
+		}
+
+		o1::hash::perfect mphf;
+		ASSERT_TRUE(mphf.build(keys.data(), keys.size()));
+		expectMinimalPerfect(mphf, keys);
+	}
+
+	TEST(o1_hash_perfect, save_and_load) {
+		auto keys = randomFingerprints(20000, 3);
+		o1::hash::perfect built;
+		ASSERT_TRUE(built.build(keys.data(), keys.size(), 2));
+
+		// dense value array: the key itself, so lookups can be verified.
+		std::vector<uint64_t> values(keys.size());
+		for (auto key: keys)
+			values[built.index(key)] = key;
+
+		auto path = tempPath();
+		built.save(path.c_str(), values.data(), sizeof(uint64_t));
+
+		o1::hash::perfect loaded;
+		loaded.load(path.c_str());
+		unlink(path.c_str());
+
+		EXPECT_EQ(loaded.size(), built.size());
+		EXPECT_EQ(loaded.bytes(), built.bytes());
+		EXPECT_EQ(loaded.valueSize(), sizeof(uint64_t));
+		ASSERT_NE(loaded.values(), nullptr);
+
+		for (auto key: keys) {
+			ASSERT_EQ(loaded.index(key), built.index(key));
+			ASSERT_EQ(loaded.value<uint64_t>(key), key);
+		}
+
+		o1::hash::perfect moved(std::move(loaded));
+		EXPECT_EQ(loaded.size(), 0);
+		EXPECT_EQ(moved.value<uint64_t>(keys[0]), keys[0]);
+	}
+
+	TEST(o1_hash_perfect, load_invalid) {
+		auto path = tempPath();
+		FILE* f = fopen(path.c_str(), "w");
+		fputs("not a perfect hash function, just some text long enough", f);
+		fclose(f);
+
+		o1::hash::perfect mphf;
+		EXPECT_THROW(mphf.load(path.c_str()), o1::errors::InvalidFormat);
+		unlink(path.c_str());
+	}
+
+	TEST(o1_hash_perfect, load_corrupted) {
+		auto keys = randomFingerprints(20000, 5);
+		o1::hash::perfect built;
+		ASSERT_TRUE(built.build(keys.data(), keys.size(), 2));
+		ASSERT_GT(built.bytes(), sizeof(o1::hash::perfect::header) + 3 * sizeof(o1::hash::perfect::partition));
+
+		auto path = tempPath();
+		built.save(path.c_str(), nullptr, 0);
+
+		// shift the buckets of a partition other than the last one.
+		const off_t offset = sizeof(o1::hash::perfect::header) + sizeof(o1::hash::perfect::partition);
+		o1::hash::perfect::partition p{};
+		int fd = open(path.c_str(), O_RDWR);
+		ASSERT_EQ(pread(fd, &p, sizeof(p), offset), ssize_t(sizeof(p)));
+		p.bucketOffset += 1000;
+		ASSERT_EQ(pwrite(fd, &p, sizeof(p), offset), ssize_t(sizeof(p)));
+		close(fd);
+
+		o1::hash::perfect mphf;
+		EXPECT_THROW(mphf.load(path.c_str()), o1::errors::InvalidFormat);
+		EXPECT_EQ(mphf.size(), 0);
+		unlink(path.c_str());
+	}
+
+	/**
+	 * Saves a function with values into a temporary file.
+	 * @return the file path.
+	 */
+	std::string saveWithValues(o1::hash::perfect& built, const std::vector<uint64_t>& keys) {
+		std::vector<uint64_t> values(keys.size());
+		for (auto key: keys)
+			values[built.index(key)] = key;
+
+		auto path = tempPath();
+		built.save(path.c_str(), values.data(), sizeof(uint64_t));
+		return path;
+	}
+
+	TEST(o1_hash_perfect, load_truncated_values) {
+		auto keys = randomFingerprints(5000, 7);
+		o1::hash::perfect built;
+		ASSERT_TRUE(built.build(keys.data(), keys.size(), 1));
+		auto path = saveWithValues(built, keys);
+
+		struct stat st;
+		ASSERT_EQ(stat(path.c_str(), &st), 0);
+		ASSERT_EQ(truncate(path.c_str(), st.st_size - sizeof(uint64_t)), 0);
+
+		o1::hash::perfect mphf;
+		EXPECT_THROW(mphf.load(path.c_str()), o1::errors::InvalidFormat);
+		EXPECT_EQ(mphf.values(), nullptr);
+		unlink(path.c_str());
+	}
+
+	TEST(o1_hash_perfect, load_values_past_eof) {
+		auto keys = randomFingerprints(5000, 9);
+		o1::hash::perfect built;
+		ASSERT_TRUE(built.build(keys.data(), keys.size(), 1));
+		auto path = saveWithValues(built, keys);
+
+		struct stat st;
+		ASSERT_EQ(stat(path.c_str(), &st), 0);
+
+		o1::hash::perfect::header h{};
+		int fd = open(path.c_str(), O_RDWR);
+		ASSERT_EQ(pread(fd, &h, sizeof(h), 0), ssize_t(sizeof(h)));
+		h.valuesOffset = (st.st_size + 4096) & ~uint64_t(63);
+		ASSERT_EQ(pwrite(fd, &h, sizeof(h), 0), ssize_t(sizeof(h)));
+		close(fd);
+
+		o1::hash::perfect mphf;
+		EXPECT_THROW(mphf.load(path.c_str()), o1::errors::InvalidFormat);
+		EXPECT_EQ(mphf.values(), nullptr);
+		unlink(path.c_str());
+	}
+
+}
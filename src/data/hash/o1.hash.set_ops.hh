@@ -0,0 +1,256 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#ifndef O1CPPLIB_O1_HASH_SET_OPS_HH
+#define O1CPPLIB_O1_HASH_SET_OPS_HH
+
+#include <mutex>
+#include <vector>
+#include "./o1.hash.table_t.hh"
+
+namespace o1 {
+
+	namespace hash {
+
+		/**
+		 * Set algebra on the keys of two tables.
+		 *
+		 * One table gets iterated (the smaller one, when the operation
+		 * allows it) in chunks of bucket ranges, possibly from several
+		 * threads, and the other one gets probed with peek(), in batches:
+		 * the bucket pointers of a whole batch are prefetched before
+		 * probing any of them.
+		 *
+		 * Neither table may be modified while an operation runs, except by
+		 * the operation itself. When numThreads > 1, the callbacks get
+		 * called concurrently (from different threads); the in-place
+		 * operations call theirs from the calling thread only.
+		 */
+		namespace set_ops {
+
+			/**
+			 * Entries probed per batch.
+			 */
+			static const constexpr size_t batchSize = 16;
+
+			/**
+			 * Calls fn(entry, other.peek(key of entry)) for each entry in
+			 * @param chunk.
+			 */
+			template <typename Key, typename Value, struct ops<Key, Value>* ops, typename Fn>
+			void probe(const std::vector<Value*>& chunk, const table<Key, Value, ops>& other, Fn& fn) {
+				hash_val hashes[batchSize];
+
+				for (size_t first = 0; first < chunk.size(); first += batchSize) {
+					size_t count = std::min(batchSize, chunk.size() - first);
+
+					for (size_t i = 0; i < count; ++i) {
+						hashes[i] = ops->hashValue(ops->getKey(chunk[first + i]));
+						other.prefetch(hashes[i]);
+					}
+
+					for (size_t i = 0; i < count; ++i) {
+						Value* value = chunk[first + i];
+						fn(value, other.peek(ops->getKey(value), hashes[i]));
+					}
+				}
+			}
+
+			/**
+			 * Calls fn(entry, found) for each entry of @param iterated,
+			 * found being the entry with the same key in @param probed (or
+			 * nullptr).
+			 */
+			template <typename Key, typename Value, struct ops<Key, Value>* ops, typename Fn>
+			void join(
+				table<Key, Value, ops>& iterated,
+				const table<Key, Value, ops>& probed,
+				unsigned numThreads,
+				Fn fn
+			) {
+				iterated.for_each_chunk(numThreads, [&probed, &fn](const std::vector<Value*>& chunk, unsigned) {
+					probe(chunk, probed, fn);
+				});
+			}
+
+			/**
+			 * Collects the entries of @param iterated for which
+			 * select(entry, found) holds (see join()).
+			 */
+			template <typename Key, typename Value, struct ops<Key, Value>* ops, typename Select>
+			std::vector<Value*> collect(
+				table<Key, Value, ops>& iterated,
+				const table<Key, Value, ops>& probed,
+				unsigned numThreads,
+				Select select
+			) {
+				std::vector<Value*> ret;
+				std::mutex mutex;
+
+				iterated.for_each_chunk(numThreads, [&](const std::vector<Value*>& chunk, unsigned) {
+					std::vector<Value*> selected;
+					auto fn = [&selected, &select](Value* value, Value* found) {
+						if (auto chosen = select(value, found))
+							selected.push_back(chosen);
+					};
+					probe(chunk, probed, fn);
+
+					std::lock_guard<std::mutex> lock(mutex);
+					ret.insert(ret.end(), selected.begin(), selected.end());
+				});
+
+				return ret;
+			}
+
+		}
+
+		/**
+		 * Calls @param fn(leftEntry, rightEntry) for each key present in
+		 * both tables; the smaller one gets iterated.
+		 */
+		template <typename Key, typename Value, struct ops<Key, Value>* ops, typename Fn>
+		void set_intersection(
+			table<Key, Value, ops>& left,
+			table<Key, Value, ops>& right,
+			Fn fn,
+			unsigned numThreads = 1
+		) {
+			if (left.size() <= right.size()) {
+				set_ops::join(left, right, numThreads, [&fn](Value* value, Value* found) {
+					if (found != nullptr)
+						fn(value, found);
+				});
+			} else {
+				set_ops::join(right, left, numThreads, [&fn](Value* value, Value* found) {
+					if (found != nullptr)
+						fn(found, value);
+				});
+			}
+		}
+
+		/**
+		 * Calls @param fn(entry) for each entry of @param left whose key
+		 * is not in @param right.
+		 */
+		template <typename Key, typename Value, struct ops<Key, Value>* ops, typename Fn>
+		void set_difference(
+			table<Key, Value, ops>& left,
+			table<Key, Value, ops>& right,
+			Fn fn,
+			unsigned numThreads = 1
+		) {
+			set_ops::join(left, right, numThreads, [&fn](Value* value, Value* found) {
+				if (found == nullptr)
+					fn(value);
+			});
+		}
+
+		/**
+		 * Calls @param fn(entry) for each entry of @param left, and for
+		 * each entry of @param right whose key is not in @param left.
+		 */
+		template <typename Key, typename Value, struct ops<Key, Value>* ops, typename Fn>
+		void set_union(
+			table<Key, Value, ops>& left,
+			table<Key, Value, ops>& right,
+			Fn fn,
+			unsigned numThreads = 1
+		) {
+			left.for_each_chunk(numThreads, [&fn](const std::vector<Value*>& chunk, unsigned) {
+				for (auto value: chunk)
+					fn(value);
+			});
+
+			set_difference(right, left, [&fn](Value* value) { fn(value); }, numThreads);
+		}
+
+		/**
+		 * In-place difference: removes from @param left the entries whose
+		 * key is in @param right, calling @param removed(entry) for each
+		 * one (entries are NOT deleted).
+		 * @return number of entries removed.
+		 */
+		template <typename Key, typename Value, struct ops<Key, Value>* ops, typename Fn>
+		size_t subtract(
+			table<Key, Value, ops>& left,
+			table<Key, Value, ops>& right,
+			Fn removed,
+			unsigned numThreads = 1
+		) {
+			std::vector<Value*> victims = left.size() <= right.size() ?
+				set_ops::collect(left, right, numThreads, [](Value* value, Value* found) {
+					return found == nullptr ? nullptr : value;
+				}) :
+				set_ops::collect(right, left, numThreads, [](Value*, Value* found) {
+					return found;
+				});
+
+			for (auto value: victims) {
+				left.remove(value);
+				removed(value);
+			}
+
+			return victims.size();
+		}
+
+		/**
+		 * In-place intersection: removes from @param left the entries whose
+		 * key is not in @param right, calling @param removed(entry) for
+		 * each one (entries are NOT deleted).
+		 * @return number of entries removed.
+		 */
+		template <typename Key, typename Value, struct ops<Key, Value>* ops, typename Fn>
+		size_t retain(
+			table<Key, Value, ops>& left,
+			table<Key, Value, ops>& right,
+			Fn removed,
+			unsigned numThreads = 1
+		) {
+			std::vector<Value*> victims = set_ops::collect(left, right, numThreads, [](Value* value, Value* found) {
+				return found == nullptr ? value : nullptr;
+			});
+
+			for (auto value: victims) {
+				left.remove(value);
+				removed(value);
+			}
+
+			return victims.size();
+		}
+
+	}
+
+}
+
+#endif //O1CPPLIB_O1_HASH_SET_OPS_HH
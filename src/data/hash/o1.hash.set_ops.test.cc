@@ -0,0 +1,166 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include "o1.hash.set_ops.hh"
+#include "o1.hash.test_fixture.hh"
+
+namespace {
+
+	using namespace o1::hash::test;
+
+	using table_t = o1::hash::table<Key, Value, &_hash_ops>;
+
+	/**
+	 * Table with nodes for keys in [first, last) stepping by step.
+	 */
+	struct fixture {
+		table_t table;
+		std::vector<HashNode*> nodes;
+
+		fixture(int first, int last, int step) {
+			for (int i = first; i < last; i += step) {
+				nodes.push_back(new HashNode(i));
+				table.insert(nodes.back());
+			}
+		}
+
+		~fixture() {
+			for (auto node: nodes)
+				delete node;
+		}
+	};
+
+	std::vector<int> sorted(std::vector<int> keys) {
+		std::sort(keys.begin(), keys.end());
+		return keys;
+	}
+
+	std::vector<int> range(int first, int last, int step) {
+		std::vector<int> ret;
+		for (int i = first; i < last; i += step)
+			ret.push_back(i);
+		return ret;
+	}
+
+	class o1_hash_set_ops: public ::testing::TestWithParam<unsigned> {
+	};
+
+	TEST_P(o1_hash_set_ops, intersection) {
+		fixture evens(0, 20000, 2);
+		fixture threes(0, 6000, 3);
+		std::mutex mutex;
+		std::vector<int> keys;
+
+		o1::hash::set_intersection(evens.table, threes.table, [&](HashNode* left, HashNode* right) {
+			EXPECT_EQ(left->key, right->key);
+			EXPECT_EQ(left->key % 2, 0);
+			std::lock_guard<std::mutex> lock(mutex);
+			keys.push_back(left->key);
+		}, GetParam());
+
+		EXPECT_EQ(sorted(keys), range(0, 6000, 6));
+	}
+
+	TEST_P(o1_hash_set_ops, difference_and_union) {
+		fixture evens(0, 2000, 2);
+		fixture threes(0, 2000, 3);
+		std::mutex mutex;
+		std::vector<int> difference;
+		std::vector<int> all;
+
+		o1::hash::set_difference(evens.table, threes.table, [&](HashNode* node) {
+			std::lock_guard<std::mutex> lock(mutex);
+			difference.push_back(node->key);
+		}, GetParam());
+
+		o1::hash::set_union(evens.table, threes.table, [&](HashNode* node) {
+			std::lock_guard<std::mutex> lock(mutex);
+			all.push_back(node->key);
+		}, GetParam());
+
+		std::vector<int> expectedDifference;
+		std::vector<int> expectedUnion;
+		for (int i = 0; i < 2000; ++i) {
+			if (i % 2 == 0 && i % 3 != 0)
+				expectedDifference.push_back(i);
+			if (i % 2 == 0 || i % 3 == 0)
+				expectedUnion.push_back(i);
+		}
+
+		EXPECT_EQ(sorted(difference), expectedDifference);
+		EXPECT_EQ(sorted(all), expectedUnion);
+	}
+
+	TEST_P(o1_hash_set_ops, subtract) {
+		// iterating the left (smaller) table, and the right one.
+		for (int last: {3000, 30000}) {
+			fixture left(0, 10000, 1);
+			fixture right(0, last, 3);
+			size_t removedCount = 0;
+
+			size_t count = o1::hash::subtract(left.table, right.table, [&](HashNode* node) {
+				EXPECT_EQ(node->key % 3, 0);
+				++removedCount;
+			}, GetParam());
+
+			EXPECT_EQ(count, removedCount);
+			EXPECT_EQ(count, (std::min(last, 10000) + 2) / 3);
+			EXPECT_EQ(left.table.size(), 10000 - count);
+			EXPECT_EQ(left.table.find(3), nullptr);
+			EXPECT_NE(left.table.find(4), nullptr);
+		}
+	}
+
+	TEST_P(o1_hash_set_ops, retain) {
+		fixture left(0, 10000, 1);
+		fixture right(0, 10000, 5);
+
+		size_t count = o1::hash::retain(left.table, right.table, [](HashNode* node) {
+			EXPECT_NE(node->key % 5, 0);
+		}, GetParam());
+
+		EXPECT_EQ(count, 8000);
+		EXPECT_EQ(left.table.size(), 2000);
+		EXPECT_NE(left.table.find(5), nullptr);
+		EXPECT_EQ(left.table.find(6), nullptr);
+	}
+
+	INSTANTIATE_TEST_SUITE_P(threads, o1_hash_set_ops, ::testing::Values(1u, 4u));
+
+}
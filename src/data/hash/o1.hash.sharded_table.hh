@@ -0,0 +1,439 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#ifndef O1CPPLIB_O1_HASH_SHARDED_TABLE_HH
+#define O1CPPLIB_O1_HASH_SHARDED_TABLE_HH
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include "../queue/o1.spsc.ring_t.hh"
+#include "./o1.hash.table_t.hh"
+
+namespace o1 {
+
+	namespace hash {
+
+		/**
+		 * Shared-nothing hash table.
+		 *
+		 * The key space is partitioned (by ops->hashValue()) in shards,
+		 * each of them being a plain o1::hash::table owned by its own
+		 * thread.  No table is ever touched by any other thread, so there
+		 * are no locks in the hot path.
+		 *
+		 * Other threads talk to the shards through a client (see
+		 * connect()): each client has a pair of single producer single
+		 * consumer rings with every shard, one for requests and another
+		 * one for responses.  Requests are published in batches (flush()),
+		 * and responses are collected in batches too (poll()).
+		 *
+		 * Values are owned by the caller, but once submitted for
+		 * insertion they belong to the shard thread until they get
+		 * removed: they must not be destroyed (their hash node would
+		 * detach itself from a table owned by another thread) nor
+		 * modified in a way that changes their key.
+		 *
+		 * @tparam Key must be default constructible & copy assignable.
+		 */
+		template <
+			typename Key,
+			typename Value,
+			struct ops<Key, Value>* ops
+		>
+		class sharded_table {
+		public:
+
+			using table_t = o1::hash::table<Key, Value, ops>;
+
+			enum class operation {
+				insert,
+				set,
+				remove,
+				find
+			};
+
+			struct request {
+				operation op;
+				Key key;
+				Value* value;
+				uint64_t tag;
+			};
+
+			/**
+			 * Outcome of a request.
+			 * - insert: ok if it was inserted, value is the one passed.
+			 * - set: ok if it was added, value is the replaced one (if any).
+			 * - remove: ok if it was found, value is the removed one.
+			 * - find: ok if it was found, value is the one found.
+			 */
+			struct response {
+				uint64_t tag;
+				bool ok;
+				Value* value;
+			};
+
+			class client;
+
+		private:
+
+			using request_ring_t = o1::spsc::ring_t<request>;
+			using response_ring_t = o1::spsc::ring_t<response>;
+
+			struct channel {
+				request_ring_t requests;
+				response_ring_t responses;
+
+				explicit channel(size_t ringSize):
+					requests(ringSize),
+					responses(ringSize) {
+				}
+			};
+
+			/**
+			 * Maximum number of requests served from a channel before
+			 * moving on to the next one.
+			 */
+			static const constexpr size_t maxBatchSize = 64;
+
+			class shard {
+				table_t _table;
+				channel** _channels;
+				size_t _maxClients;
+				std::atomic<size_t>& _connectedClients;
+				std::atomic<size_t> _size{0};
+				std::atomic<bool>& _stop;
+				std::thread _thread;
+
+				void execute(const request& req, response& res) {
+					res.tag = req.tag;
+					res.value = nullptr;
+
+					switch (req.op) {
+						case operation::insert:
+							res.ok = _table.insert(req.value);
+							res.value = req.value;
+							break;
+						case operation::set:
+							res.ok = _table.set(req.value, &res.value);
+							break;
+						case operation::remove:
+							res.ok = _table.remove(req.key, &res.value);
+							break;
+						case operation::find:
+							res.value = _table.find(req.key);
+							res.ok = res.value != nullptr;
+							break;
+					}
+				}
+
+				/**
+				 * Serves up to maxBatchSize requests from @param _channel.
+				 * A request is only taken if there's room for its response,
+				 * so a client that does not poll() can't block the shard.
+				 * @return number of requests served.
+				 */
+				size_t serve(channel* _channel) {
+					size_t served = 0;
+					request req;
+					response res{};
+
+					while (
+						served < maxBatchSize &&
+						_channel->responses.writable() &&
+						_channel->requests.pop(req)
+					) {
+						execute(req, res);
+						_channel->responses.push(res);
+						++served;
+					}
+
+					if (served > 0) {
+						_channel->requests.release();
+						_channel->responses.commit();
+						_size.store(_table.size(), std::memory_order_relaxed);
+					}
+
+					return served;
+				}
+
+				void run() {
+					while (!_stop.load(std::memory_order_acquire)) {
+						size_t served = 0;
+						size_t clients = _connectedClients.load(std::memory_order_acquire);
+
+						for (size_t i = 0; i < clients; ++i)
+							served += serve(_channels[i]);
+
+						if (served == 0)
+							std::this_thread::yield();
+					}
+				}
+
+			public:
+				shard(
+					size_t maxClients,
+					size_t ringSize,
+					std::atomic<size_t>& connectedClients,
+					std::atomic<bool>& stop
+				):
+					_channels(new channel*[maxClients]),
+					_maxClients(maxClients),
+					_connectedClients(connectedClients),
+					_stop(stop) {
+
+					for (size_t i = 0; i < maxClients; ++i)
+						_channels[i] = new channel(ringSize);
+				}
+
+				shard(const shard& that) = delete;
+
+				shard(shard&& that) = delete;
+
+				~shard() {
+					join();
+					for (size_t i = 0; i < _maxClients; ++i)
+						delete _channels[i];
+					delete[] _channels;
+				}
+
+				void start() {
+					_thread = std::thread(&shard::run, this);
+				}
+
+				void join() {
+					if (_thread.joinable())
+						_thread.join();
+				}
+
+				inline channel* getChannel(size_t client) { return _channels[client]; }
+
+				/**
+				 * Approximate number of elements, as seen by the last
+				 * served batch.
+				 */
+				inline size_t size() const { return _size.load(std::memory_order_relaxed); }
+
+			};
+
+			size_t _numShards;
+			size_t _maxClients;
+			std::atomic<size_t> _connectedClients{0};
+			std::atomic<size_t> _claimedClients{0};
+			std::atomic<bool> _stop{false};
+			shard** _shards;
+			client** _clients;
+
+		public:
+
+			/**
+			 * Per-thread access point to the sharded table.
+			 * A client must only be used by one thread at a time.
+			 */
+			class client {
+				sharded_table* _table;
+				size_t _index;
+
+				friend class sharded_table;
+
+				client(sharded_table* table, size_t index):
+					_table(table),
+					_index(index) {
+				}
+
+				channel* getChannel(size_t shard) {
+					return _table->_shards[shard]->getChannel(_index);
+				}
+
+			public:
+
+				client(const client& that) = delete;
+
+				client(client&& that) = delete;
+
+				/**
+				 * Queues a request for the shard owning @param key.
+				 * Requests are not seen by the shard until flush().
+				 * @return false if the shard ring is full; flush() & poll()
+				 *         responses before retrying.
+				 */
+				bool submit(operation op, const Key& key, Value* value, uint64_t tag) {
+					request req{op, key, value, tag};
+					return getChannel(_table->shardIndex(ops->hashValue(key)))
+						->requests.push(req);
+				}
+
+				inline bool insert(Value* value, uint64_t tag) {
+					return submit(operation::insert, ops->getKey(value), value, tag);
+				}
+
+				inline bool set(Value* value, uint64_t tag) {
+					return submit(operation::set, ops->getKey(value), value, tag);
+				}
+
+				inline bool remove(const Key& key, uint64_t tag) {
+					return submit(operation::remove, key, nullptr, tag);
+				}
+
+				inline bool find(const Key& key, uint64_t tag) {
+					return submit(operation::find, key, nullptr, tag);
+				}
+
+				/**
+				 * Publish all the submitted requests to their shards.
+				 */
+				void flush() {
+					for (size_t i = 0; i < _table->_numShards; ++i)
+						getChannel(i)->requests.commit();
+				}
+
+				/**
+				 * Collects up to @param max responses (from any shard) into
+				 * @param out.
+				 * Responses from the same shard keep the submission order.
+				 * @return number of responses stored in @param out.
+				 */
+				size_t poll(response* out, size_t max) {
+					size_t collected = 0;
+
+					for (size_t i = 0; i < _table->_numShards && collected < max; ++i) {
+						auto& responses = getChannel(i)->responses;
+						size_t before = collected;
+
+						while (collected < max && responses.pop(out[collected]))
+							++collected;
+
+						if (collected != before)
+							responses.release();
+					}
+
+					return collected;
+				}
+
+			};
+
+			sharded_table() = delete;
+
+			/**
+			 * Starts @param numShards threads, each one owning a table.
+			 * @param maxClients maximum number of clients (see connect()).
+			 * @param ringSize capacity of each request & response ring.
+			 */
+			sharded_table(size_t numShards, size_t maxClients, size_t ringSize = 1024):
+				_numShards(numShards),
+				_maxClients(maxClients),
+				_shards(new shard*[numShards]),
+				_clients(new client*[maxClients]{nullptr}) {
+
+				o1::xassert(numShards > 0, "o1::hash::sharded_table: at least one shard is needed");
+
+				for (size_t i = 0; i < _numShards; ++i)
+					_shards[i] = new shard(maxClients, ringSize, _connectedClients, _stop);
+
+				for (size_t i = 0; i < _numShards; ++i)
+					_shards[i]->start();
+			}
+
+			sharded_table(const sharded_table& that) = delete;
+
+			sharded_table(sharded_table&& that) = delete;
+
+			/**
+			 * Stops the shard threads; pending requests are discarded.
+			 * Values still in the tables are NOT deleted.
+			 */
+			~sharded_table() {
+				_stop.store(true, std::memory_order_release);
+
+				for (size_t i = 0; i < _numShards; ++i)
+					delete _shards[i];
+				delete[] _shards;
+
+				for (size_t i = 0; i < _maxClients; ++i)
+					delete _clients[i];
+				delete[] _clients;
+			}
+
+			/**
+			 * Given a hash value, return the index of the shard owning it.
+			 * The hash value is scrambled before picking the shard, so
+			 * the low bits (used by each table to pick the bucket) remain
+			 * well distributed inside every shard.
+			 */
+			inline size_t shardIndex(hash_val hashValue) const {
+				uint32_t mixed = hashValue * UINT32_C(0x9E3779B1);
+				return static_cast<size_t>(
+					(static_cast<uint64_t>(mixed) * _numShards) >> 32
+				);
+			}
+
+			inline size_t numShards() const { return _numShards; }
+
+			/**
+			 * Registers a new client, to be used by a single thread.
+			 * The client is owned by the sharded_table.
+			 */
+			client* connect() {
+				size_t index = _claimedClients.fetch_add(1);
+				o1::xassert(index < _maxClients, "o1::hash::sharded_table: too many clients");
+
+				_clients[index] = new client(this, index);
+
+				// shards serve clients in [0, _connectedClients)
+				size_t expected = index;
+				while (!_connectedClients.compare_exchange_weak(expected, index + 1)) {
+					expected = index;
+					std::this_thread::yield();
+				}
+
+				return _clients[index];
+			}
+
+			/**
+			 * Approximate number of elements in all the shards.
+			 */
+			size_t size() const {
+				size_t ret = 0;
+				for (size_t i = 0; i < _numShards; ++i)
+					ret += _shards[i]->size();
+				return ret;
+			}
+
+		};
+
+	}
+
+}
+
+#endif //O1CPPLIB_O1_HASH_SHARDED_TABLE_HH
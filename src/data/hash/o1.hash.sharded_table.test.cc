@@ -0,0 +1,187 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "o1.hash.sharded_table.hh"
+#include "o1.hash.test_fixture.hh"
+
+namespace {
+
+	using namespace o1::hash::test;
+
+	using sharded_table = o1::hash::sharded_table<Key, Value, &_hash_ops>;
+	using operation = sharded_table::operation;
+	using response = sharded_table::response;
+
+	/**
+	 * Submits a request, draining responses into @param results while
+	 * the ring is full.
+	 */
+	void submit(
+		sharded_table::client* client,
+		operation op,
+		int key,
+		HashNode* value,
+		uint64_t tag,
+		std::vector<response>& results
+	) {
+		response batch[32];
+
+		while (!client->submit(op, key, value, tag)) {
+			client->flush();
+			size_t n = client->poll(batch, 32);
+			results.insert(results.end(), batch, batch + n);
+		}
+	}
+
+	/**
+	 * Flush & poll until @param expected responses were collected.
+	 */
+	void drain(
+		sharded_table::client* client,
+		size_t expected,
+		std::vector<response>& results
+	) {
+		response batch[32];
+		client->flush();
+		while (results.size() < expected) {
+			size_t n = client->poll(batch, 32);
+			results.insert(results.end(), batch, batch + n);
+			if (n == 0)
+				std::this_thread::yield();
+		}
+	}
+
+	TEST(o1_hash_sharded_table, basic_tests) {
+		sharded_table table(4, 1, 16);
+		auto client = table.connect();
+		HashNode node{1};
+		std::vector<response> results;
+
+		submit(client, operation::insert, 1, &node, 0, results);
+		submit(client, operation::find, 1, nullptr, 1, results);
+		submit(client, operation::find, 2, nullptr, 2, results);
+		submit(client, operation::remove, 1, nullptr, 3, results);
+		submit(client, operation::find, 1, nullptr, 4, results);
+		drain(client, 5, results);
+
+		// responses from different shards may come in any order.
+		ASSERT_EQ(results.size(), 5);
+		std::vector<response> byTag(5);
+		for (auto& result: results)
+			byTag[result.tag] = result;
+
+		EXPECT_TRUE(byTag[0].ok);
+		EXPECT_TRUE(byTag[1].ok);
+		EXPECT_EQ(byTag[1].value, &node);
+		EXPECT_FALSE(byTag[2].ok);
+		EXPECT_EQ(byTag[2].value, nullptr);
+		EXPECT_TRUE(byTag[3].ok);
+		EXPECT_EQ(byTag[3].value, &node);
+		EXPECT_FALSE(byTag[4].ok);
+	}
+
+	TEST(o1_hash_sharded_table, concurrent_clients) {
+		const int numClients = 3;
+		const int keysPerClient = 2000;
+
+		sharded_table table(4, numClients, 64);
+		std::vector<HashNode*> nodes;
+
+		for (int i = 0; i < numClients * keysPerClient; ++i)
+			nodes.push_back(new HashNode(i));
+
+		std::vector<std::thread> threads;
+		std::vector<size_t> failures(numClients, 0);
+
+		for (int c = 0; c < numClients; ++c) {
+			threads.emplace_back([&table, &nodes, &failures, c]() {
+				auto client = table.connect();
+				std::vector<response> results;
+				int first = c * keysPerClient;
+
+				for (int i = first; i < first + keysPerClient; ++i)
+					submit(client, operation::insert, i, nodes[i], i, results);
+				drain(client, keysPerClient, results);
+
+				for (int i = first; i < first + keysPerClient; ++i)
+					submit(client, operation::find, i, nullptr, i, results);
+				drain(client, 2 * keysPerClient, results);
+
+				for (auto& result: results) {
+					if (!result.ok || result.value != nodes[result.tag])
+						++failures[c];
+				}
+
+				results.clear();
+				for (int i = first; i < first + keysPerClient; ++i)
+					submit(client, operation::remove, i, nullptr, i, results);
+				drain(client, keysPerClient, results);
+
+				for (auto& result: results) {
+					if (!result.ok || result.value != nodes[result.tag])
+						++failures[c];
+				}
+			});
+		}
+
+		for (auto& thread: threads)
+			thread.join();
+
+		for (int c = 0; c < numClients; ++c)
+			EXPECT_EQ(failures[c], 0) << "client " << c;
+
+		EXPECT_EQ(table.size(), 0);
+
+		for (auto node: nodes)
+			delete node;
+	}
+
+	TEST(o1_hash_sharded_table, shardIndex) {
+		sharded_table table(3, 1);
+		size_t hits[3]{0};
+
+		for (int i = 0; i < 3000; ++i) {
+			size_t index = table.shardIndex(hashFn(i));
+			ASSERT_LT(index, 3);
+			++hits[index];
+		}
+
+		for (auto count: hits)
+			EXPECT_GT(count, 500);
+	}
+
+}
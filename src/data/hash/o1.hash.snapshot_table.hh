@@ -0,0 +1,453 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#ifndef O1CPPLIB_O1_HASH_SNAPSHOT_TABLE_HH
+#define O1CPPLIB_O1_HASH_SNAPSHOT_TABLE_HH
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "./o1.hash.table_t.hh"
+
+namespace o1 {
+
+	namespace hash {
+
+		/**
+		 * Hash table whose contents can be scanned through a consistent
+		 * snapshot, while other threads keep modifying it.
+		 *
+		 * Taking a snapshot is cheap: nothing gets copied.  The table is
+		 * split in partitions (the buckets of the current slot when the
+		 * snapshot gets taken), and the first time a writer modifies a
+		 * partition the snapshot has not scanned yet, it copies the
+		 * entries of that partition for the snapshot (copy-on-write at
+		 * bucket granularity).  The snapshot scans one partition at a
+		 * time, holding the table lock only while copying it, so writers
+		 * are never blocked for the duration of a scan.
+		 *
+		 * All operations are serialized with a mutex held for the
+		 * duration of the operation.
+		 *
+		 * Caveats:
+		 * - entries must be removed through the table (not by destroying
+		 *   them) while there are snapshots alive; use retire() to
+		 *   destroy removed entries once no snapshot can see them.
+		 * - snapshots must not outlive the table.
+		 */
+		template <
+			typename Key,
+			typename Value,
+			struct ops<Key, Value>* ops
+		>
+		class snapshot_table: protected o1::hash::table<Key, Value, ops> {
+		public:
+
+			using table_t = o1::hash::table<Key, Value, ops>;
+			using deleterFn = void (*)(Value*);
+
+			class snapshot;
+
+		private:
+
+			/**
+			 * Entries retired while there were snapshots alive.
+			 * Each reclaimer keeps the next (newer) one alive, so an
+			 * entry retired after a snapshot got taken is not released
+			 * until that snapshot goes away.
+			 */
+			class reclaimer {
+				std::vector<std::pair<Value*, deleterFn>> _retired;
+			public:
+				std::shared_ptr<reclaimer> next;
+
+				reclaimer() = default;
+
+				reclaimer(const reclaimer& that) = delete;
+
+				~reclaimer() {
+					for (auto& i: _retired)
+						i.second(i.first);
+				}
+
+				void retire(Value* value, deleterFn deleter) {
+					_retired.emplace_back(value, deleter);
+				}
+
+				bool empty() const { return _retired.empty(); }
+			};
+
+			/**
+			 * Snapshot state, shared by the snapshot handles & the table.
+			 */
+			struct state {
+				snapshot_table* table;
+				std::shared_ptr<reclaimer> _reclaimer;
+
+				/**
+				 * Number of partitions (a power of 2).
+				 */
+				size_t numPartitions;
+
+				/**
+				 * Next partition to be scanned.
+				 */
+				size_t cursor{0};
+
+				/**
+				 * Partitions the snapshot has already scanned.
+				 */
+				std::vector<bool> visited;
+
+				/**
+				 * Partitions copied by writers before being scanned.
+				 */
+				std::unordered_map<size_t, std::vector<Value*>> frozen;
+
+				state(
+					snapshot_table* _table,
+					std::shared_ptr<reclaimer> __reclaimer,
+					size_t _numPartitions
+				):
+					table(_table),
+					_reclaimer(std::move(__reclaimer)),
+					numPartitions(_numPartitions),
+					visited(_numPartitions, false) {
+				}
+
+				state(const state& that) = delete;
+
+				~state() {
+					{
+						std::lock_guard<std::mutex> lock(table->_mutex);
+						auto& active = table->_snapshots;
+						for (size_t i = 0; i < active.size(); ++i) {
+							if (active[i] == this) {
+								active[i] = active.back();
+								active.pop_back();
+								break;
+							}
+						}
+					}
+
+					// w/out holding the lock, as it may release entries.
+					_reclaimer.reset();
+					table->reclaim();
+				}
+			};
+
+			mutable std::mutex _mutex;
+			std::vector<state*> _snapshots;
+			std::shared_ptr<reclaimer> _reclaimer{std::make_shared<reclaimer>()};
+
+			/**
+			 * Appends to @param out the entries of the @param partition
+			 * (out of @param numPartitions), from all the slots.
+			 * Must be called with the lock held.
+			 */
+			void collect(size_t partition, size_t numPartitions, std::vector<Value*>& out) {
+				if (this->slots == nullptr) {
+					// small table: no buckets to pick the partition from.
+					for (auto& value: this->_elements) {
+						hash_val hashValue = ops->hashValue(ops->getKey(&value));
+						if ((hashValue & (numPartitions - 1)) == partition)
+							out.push_back(&value);
+					}
+					return;
+				}
+
+				for (
+					size_t iSlot = 0;
+					iSlot <= this->sizingStrategy.maxSizingIndex();
+					++iSlot)
+				{
+					auto buckets = this->slots[iSlot];
+					if (buckets == nullptr)
+						continue;
+
+					size_t numBuckets = buckets->numBuckets();
+
+					if (numBuckets >= numPartitions) {
+						// several buckets per partition.
+						for (size_t i = partition; i < numBuckets; i += numPartitions) {
+							if (auto bucket = buckets->bucket(i))
+								bucket->forEach([&out](Value* value) { out.push_back(value); });
+						}
+
+					} else if (auto bucket = buckets->bucket(partition & (numBuckets - 1))) {
+						// several partitions per bucket.
+						bucket->forEach([&out, partition, numPartitions](Value* value) {
+							hash_val hashValue = ops->hashValue(ops->getKey(value));
+							if ((hashValue & (numPartitions - 1)) == partition)
+								out.push_back(value);
+						});
+					}
+				}
+			}
+
+			/**
+			 * Called before modifying the partition of @param hashValue:
+			 * copies it for each snapshot that did not scan it yet.
+			 * Must be called with the lock held.
+			 */
+			void copyOnWrite(hash_val hashValue) {
+				for (auto snapshot: _snapshots) {
+					size_t partition = hashValue & (snapshot->numPartitions - 1);
+
+					if (snapshot->visited[partition])
+						continue;
+
+					if (snapshot->frozen.count(partition) != 0)
+						continue;
+
+					collect(partition, snapshot->numPartitions, snapshot->frozen[partition]);
+				}
+			}
+
+			inline void copyOnWrite(const Key& key) {
+				if (!_snapshots.empty())
+					copyOnWrite(ops->hashValue(key));
+			}
+
+			/**
+			 * Releases the entries retired into the current reclaimer,
+			 * if there are no snapshots left.
+			 */
+			void reclaim() {
+				std::shared_ptr<reclaimer> released;
+
+				{
+					std::lock_guard<std::mutex> lock(_mutex);
+					if (!_snapshots.empty() || _reclaimer->empty())
+						return;
+					released = std::move(_reclaimer);
+					_reclaimer = std::make_shared<reclaimer>();
+				}
+
+				// released entries get deleted here, unless some snapshot
+				// being destroyed still holds them.
+			}
+
+		public:
+
+			/**
+			 * Consistent view of the table, as it was when the snapshot
+			 * got taken.
+			 * Copies share the scan position.
+			 */
+			class snapshot {
+				std::shared_ptr<state> _state;
+
+				friend class snapshot_table;
+
+				explicit snapshot(std::shared_ptr<state> __state):
+					_state(std::move(__state)) {
+				}
+
+			public:
+
+				/**
+				 * @return number of partitions (the scan granularity).
+				 */
+				inline size_t numPartitions() const { return _state->numPartitions; }
+
+				/**
+				 * Copies the entries of the next partition into @param out
+				 * (which gets cleared first).
+				 * The table lock is only held while copying.
+				 * @return false once all partitions were scanned.
+				 */
+				bool next(std::vector<Value*>& out) {
+					out.clear();
+
+					if (_state->cursor == _state->numPartitions)
+						return false;
+
+					size_t partition = _state->cursor++;
+					auto table = _state->table;
+					std::lock_guard<std::mutex> lock(table->_mutex);
+
+					auto frozen = _state->frozen.find(partition);
+
+					if (frozen == _state->frozen.end()) {
+						table->collect(partition, _state->numPartitions, out);
+					} else {
+						out.swap(frozen->second);
+						_state->frozen.erase(frozen);
+					}
+
+					_state->visited[partition] = true;
+					return true;
+				}
+
+				/**
+				 * Calls @param fn(Value*) for each remaining entry of the
+				 * snapshot.  The table is not locked while @param fn runs.
+				 */
+				template <typename Fn>
+				void for_each(Fn fn) {
+					std::vector<Value*> values;
+					while (next(values)) {
+						for (auto value: values)
+							fn(value);
+					}
+				}
+
+			};
+
+			snapshot_table() = default;
+
+			snapshot_table(const snapshot_table& that) = delete;
+
+			snapshot_table(snapshot_table&& that) = delete;
+
+			~snapshot_table() {
+				o1::xassert(_snapshots.empty(), "o1::hash::snapshot_table destroyed with live snapshots");
+			}
+
+			/**
+			 * Takes a snapshot of the table.
+			 * No entries are copied here.
+			 */
+			snapshot take_snapshot() {
+				std::lock_guard<std::mutex> lock(_mutex);
+
+				// entries retired from now on must outlive this snapshot,
+				// and the ones retired before don't need to.
+				if (!_reclaimer->empty()) {
+					auto newer = std::make_shared<reclaimer>();
+					_reclaimer->next = newer;
+					_reclaimer = newer;
+				}
+
+				size_t numPartitions =
+					this->slots == nullptr || this->slots[this->currentSlot] == nullptr ?
+					1 :
+					this->slots[this->currentSlot]->numBuckets();
+
+				auto _state = std::make_shared<state>(this, _reclaimer, numPartitions);
+				_snapshots.push_back(_state.get());
+				return snapshot(_state);
+			}
+
+			/**
+			 * Destroys @param value (calling @param deleter) as soon as
+			 * no snapshot taken before this call is alive.
+			 * @param value must not be in the table.
+			 */
+			void retire(Value* value, deleterFn deleter) {
+				std::unique_lock<std::mutex> lock(_mutex);
+
+				if (!_snapshots.empty()) {
+					_reclaimer->retire(value, deleter);
+					return;
+				}
+
+				lock.unlock();
+				deleter(value);
+			}
+
+			/**
+			 * @return number of snapshots alive.
+			 */
+			size_t snapshots() const {
+				std::lock_guard<std::mutex> lock(_mutex);
+				return _snapshots.size();
+			}
+
+			size_t size() const {
+				std::lock_guard<std::mutex> lock(_mutex);
+				return table_t::size();
+			}
+
+			bool empty() const {
+				std::lock_guard<std::mutex> lock(_mutex);
+				return table_t::empty();
+			}
+
+			bool insert(Value* value) {
+				std::lock_guard<std::mutex> lock(_mutex);
+				copyOnWrite(ops->getKey(value));
+				return table_t::insert(value);
+			}
+
+			bool set(Value* value, Value** old_value = nullptr) {
+				std::lock_guard<std::mutex> lock(_mutex);
+				copyOnWrite(ops->getKey(value));
+				return table_t::set(value, old_value);
+			}
+
+			bool replace(Value* value, Value** old_value = nullptr) {
+				std::lock_guard<std::mutex> lock(_mutex);
+				copyOnWrite(ops->getKey(value));
+				return table_t::replace(value, old_value);
+			}
+
+			bool remove(Value* value, Value** old_value = nullptr) {
+				return remove(ops->getKey(value), old_value);
+			}
+
+			bool remove(const Key& key, Value** old_value = nullptr) {
+				std::lock_guard<std::mutex> lock(_mutex);
+				copyOnWrite(key);
+				return table_t::remove(key, old_value);
+			}
+
+			template <typename Factory>
+			Value* find_or_insert(const Key& key, Factory factory, bool* inserted = nullptr) {
+				std::lock_guard<std::mutex> lock(_mutex);
+				copyOnWrite(key);
+				return table_t::find_or_insert(key, factory, inserted);
+			}
+
+			template <typename Update, typename Factory>
+			Value* upsert(const Key& key, Update update, Factory factory) {
+				std::lock_guard<std::mutex> lock(_mutex);
+				copyOnWrite(key);
+				return table_t::upsert(key, update, factory);
+			}
+
+			Value* find(const Key& key) {
+				std::lock_guard<std::mutex> lock(_mutex);
+				return table_t::find(key);
+			}
+
+		};
+
+	}
+
+}
+
+#endif //O1CPPLIB_O1_HASH_SNAPSHOT_TABLE_HH
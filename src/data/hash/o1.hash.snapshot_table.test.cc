@@ -0,0 +1,219 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "o1.hash.snapshot_table.hh"
+#include "o1.hash.test_fixture.hh"
+
+namespace {
+
+	using namespace o1::hash::test;
+
+	using snapshot_table = o1::hash::snapshot_table<Key, Value, &_hash_ops>;
+
+	std::atomic<int> deleted{0};
+
+	void deleteNode(HashNode* node) {
+		++deleted;
+		delete node;
+	}
+
+	std::vector<int> keys(snapshot_table::snapshot& snapshot) {
+		std::vector<int> ret;
+		snapshot.for_each([&ret](HashNode* node) { ret.push_back(node->key); });
+		std::sort(ret.begin(), ret.end());
+		return ret;
+	}
+
+	std::vector<int> range(int first, int last) {
+		std::vector<int> ret;
+		for (int i = first; i < last; ++i)
+			ret.push_back(i);
+		return ret;
+	}
+
+	TEST(o1_hash_snapshot_table, empty) {
+		snapshot_table table;
+		auto snapshot = table.take_snapshot();
+		EXPECT_TRUE(keys(snapshot).empty());
+	}
+
+	TEST(o1_hash_snapshot_table, consistent_view) {
+		snapshot_table table;
+		const int count = 1000;
+
+		for (int i = 0; i < count; ++i)
+			table.insert(new HashNode(i));
+
+		{
+			auto snapshot = table.take_snapshot();
+			EXPECT_EQ(table.snapshots(), 1);
+
+			// scan a few partitions before modifying the table.
+			std::vector<Value*> partition;
+			std::vector<int> seen;
+			for (int i = 0; i < 3 && snapshot.next(partition); ++i) {
+				for (auto value: partition)
+					seen.push_back(value->key);
+			}
+
+			for (int i = 0; i < count; i += 2) {
+				HashNode* old_value = nullptr;
+				EXPECT_TRUE(table.remove(i, &old_value));
+				table.retire(old_value, deleteNode);
+			}
+
+			for (int i = count; i < 3 * count; ++i)
+				table.insert(new HashNode(i));
+
+			for (auto key: keys(snapshot))
+				seen.push_back(key);
+			std::sort(seen.begin(), seen.end());
+
+			EXPECT_EQ(seen, range(0, count));
+			EXPECT_EQ(deleted.load(), 0);
+		}
+
+		EXPECT_EQ(table.snapshots(), 0);
+		EXPECT_EQ(deleted.load(), count / 2);
+		EXPECT_EQ(table.size(), 2 * count + count / 2);
+
+		auto snapshot = table.take_snapshot();
+		auto all = keys(snapshot);
+		EXPECT_EQ(all.size(), table.size());
+
+		for (auto key: all) {
+			HashNode* old_value = nullptr;
+			table.remove(key, &old_value);
+			delete old_value;
+		}
+
+		deleted = 0;
+	}
+
+	TEST(o1_hash_snapshot_table, retire_waits_for_older_snapshots_only) {
+		snapshot_table table;
+		auto node = new HashNode(1);
+		table.insert(node);
+
+		auto older = new snapshot_table::snapshot(table.take_snapshot());
+
+		table.remove(node);
+		table.retire(node, deleteNode);
+
+		{
+			auto newer = table.take_snapshot();
+			EXPECT_TRUE(keys(newer).empty());
+			EXPECT_EQ(deleted.load(), 0);
+
+			EXPECT_EQ(keys(*older), std::vector<int>{1});
+			delete older;
+			EXPECT_EQ(deleted.load(), 1);
+
+			table.retire(new HashNode(2), deleteNode);
+			EXPECT_EQ(deleted.load(), 1);
+		}
+
+		EXPECT_EQ(deleted.load(), 2);
+
+		table.retire(new HashNode(3), deleteNode);
+		EXPECT_EQ(deleted.load(), 3);
+
+		deleted = 0;
+	}
+
+	TEST(o1_hash_snapshot_table, concurrent_writer) {
+		snapshot_table table;
+		const int count = 20000;
+
+		for (int i = 0; i < count; ++i)
+			table.insert(new HashNode(i));
+
+		auto snapshot = table.take_snapshot();
+
+		std::thread writer([&table]() {
+			for (int i = 0; i < count; ++i) {
+				HashNode* old_value = nullptr;
+				table.remove(i, &old_value);
+				table.retire(old_value, deleteNode);
+				table.insert(new HashNode(count + i));
+			}
+		});
+
+		auto seen = keys(snapshot);
+		writer.join();
+
+		EXPECT_EQ(seen, range(0, count));
+
+		snapshot = table.take_snapshot();
+		auto all = keys(snapshot);
+		EXPECT_EQ(all, range(count, 2 * count));
+
+		for (auto key: all) {
+			HashNode* old_value = nullptr;
+			table.remove(key, &old_value);
+			delete old_value;
+		}
+
+		deleted = 0;
+	}
+
+	TEST(o1_hash_snapshot_table, upsert) {
+		snapshot_table table;
+		int updates = 0;
+
+		for (int i = 0; i < 100; ++i) {
+			table.upsert(i % 10, [&updates](HashNode*) { ++updates; }, [i]() { return new HashNode(i % 10); });
+		}
+
+		EXPECT_EQ(table.size(), 10);
+		EXPECT_EQ(updates, 90);
+
+		bool inserted = true;
+		auto node = table.find_or_insert(3, []() -> HashNode* { return nullptr; }, &inserted);
+		EXPECT_FALSE(inserted);
+
+		for (int i = 0; i < 10; ++i) {
+			HashNode* old_value = nullptr;
+			EXPECT_TRUE(table.remove(i, &old_value));
+			EXPECT_TRUE(i != 3 || old_value == node);
+			delete old_value;
+		}
+	}
+
+}
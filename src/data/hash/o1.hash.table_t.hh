@@ -35,10 +35,15 @@
 #ifndef O1CPPLIB_O1_HASH_TABLE_T_HH
 #define O1CPPLIB_O1_HASH_TABLE_T_HH
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <thread>
+#include <vector>
 #include "./o1.hash.ops_t.hh"
 #include "./o1.hash.bucket_t.hh"
 #include "./o1.hash.buckets_t.hh"
+#include "./o1.hash.parallel.hh"
 #include "./o1.hash.sizing_strategy.hh"
 #include "./o1.hash.conf.hh"
 
@@ -46,6 +51,13 @@ namespace o1 {
 
 	namespace hash {
 
+		/**
+		 * Capacity of a fixed capacity table (see table).
+		 */
+		struct fixed_capacity {
+			size_t capacity;
+		};
+
 		/**
 		 * If the key is an integer, perhaps it's a good thing to convert it
 		 * to network byte order (using o1::hton<int_type_t>) to make it
@@ -91,15 +103,48 @@ namespace o1 {
 				return slots[currentSlot];
 			}
 
+			/**
+			 * Bucket vector allocated ahead of time (by a helper thread,
+			 * see background_table); used by rehash() when a slot of its
+			 * size is needed.
+			 */
+			buckets_t* spare{nullptr};
+
+			/**
+			 * Number of entries moved between slots by rehash().
+			 */
+			size_t rehashedElements{0};
+
+			/**
+			 * Number of bucket vectors released by rehash() and toSmall()
+			 * (a new one may get allocated at the same address).
+			 */
+			size_t releasedSlots{0};
+
+			/**
+			 * Maximum number of entries, 0 if the table may grow.
+			 */
+			size_t fixedCapacity{0};
+
 			void rehash(hash_val hashValue) {
+				// fixed capacity tables never change their bucket vector.
+				if (fixedCapacity != 0)
+					return;
 
 				currentSlot = sizingStrategy.sizeIndex(currentSlot, _elements.size());
 
 				if (slots == nullptr)
 					slots = new buckets_t*[sizingStrategy.maxSizingIndex() + 1]{nullptr};
 
-				if (slots[currentSlot] == nullptr)
-					slots[currentSlot] = new buckets_t(sizingStrategy.numBuckets(currentSlot));
+				if (slots[currentSlot] == nullptr) {
+					size_t numBuckets = sizingStrategy.numBuckets(currentSlot);
+					if (spare != nullptr && spare->numBuckets() == numBuckets) {
+						slots[currentSlot] = spare;
+						spare = nullptr;
+					} else {
+						slots[currentSlot] = new buckets_t(numBuckets);
+					}
+				}
 
 				for (
 					size_t iSlot = 0;
@@ -112,17 +157,127 @@ namespace o1 {
 					if (slots[iSlot] == nullptr)
 						continue;
 
-					slots[iSlot]->rehashInto(slots[currentSlot], hashValue);
+					rehashedElements += slots[iSlot]->rehashInto(slots[currentSlot], hashValue);
 
 					if (slots[iSlot]->empty()) {
 						delete slots[iSlot];
 						slots[iSlot] = nullptr;
+						++releasedSlots;
 					}
 
 				}
 
 			}
 
+			/**
+			 * Small tables (see O1_HASH_TABLE_SMALL_SIZE) keep no bucket
+			 * vectors at all: entries are only linked into _elements, and
+			 * looked up by walking it (comparing keys, w/out hashing them).
+			 */
+			static const constexpr size_t smallSize = O1_HASH_TABLE_SMALL_SIZE;
+
+			/**
+			 * Switches representation, if needed, before an operation.
+			 * Tables grow out of small mode when an entry may be added to
+			 * a full one, and get back to it once down to smallSize / 2
+			 * entries (so that a table of about smallSize entries does not
+			 * flip on every insert/remove).
+			 * @param adding whether the operation may add an entry.
+			 * @return true if the operation is to be done in small mode.
+			 */
+			bool small(bool adding) {
+				if (fixedCapacity != 0)
+					return false;
+
+				size_t count = _elements.size();
+
+				if (slots == nullptr) {
+					if (count + adding <= smallSize)
+						return true;
+					toBuckets();
+				} else if (count <= smallSize / 2 && smallSize > 0) {
+					toSmall();
+					return true;
+				}
+
+				return false;
+			}
+
+			/**
+			 * Links all the entries into a newly allocated bucket vector.
+			 */
+			void toBuckets() {
+				rehash(0);
+
+				auto buckets = getCurrentSlot();
+				for (auto& value: _elements) {
+					auto key = ops->getKey(&value);
+					buckets->insert(key, ops->hashValue(key), &value);
+				}
+			}
+
+			/**
+			 * Releases all the bucket vectors (detaching the entries from
+			 * their buckets).
+			 */
+			void toSmall() {
+				for (size_t i = 0; i <= sizingStrategy.maxSizingIndex(); ++i) {
+					if (slots[i] != nullptr)
+						++releasedSlots;
+					delete slots[i];
+				}
+				delete[] slots;
+				slots = nullptr;
+				currentSlot = 0;
+			}
+
+			Value* smallFind(const Key& key) const {
+				for (auto& value: _elements) {
+					if (ops->equal(key, ops->getKey(&value)))
+						return const_cast<Value*>(&value);
+				}
+				return nullptr;
+			}
+
+			/**
+			 * Calls @param fn(Value*) on each entry, in small mode.
+			 * @param fn may detach the entry it got, but no other one.
+			 */
+			template <typename Fn>
+			void smallForEach(Fn fn) {
+				using node_t = typename o1::hash::list_t<Value>::node_t;
+				node_t* node = _elements.start();
+				while (node != nullptr) {
+					o1::d_linked::node* next = node->next();
+					Value* value = node->ref();
+					node = next == _elements.finish() ? nullptr : static_cast<node_t*>(next);
+					fn(value);
+				}
+			}
+
+			static size_t reverseBits(size_t v) {
+				size_t ret = 0;
+				for (size_t i = 0; i < 8 * sizeof(v); ++i) {
+					ret = (ret << 1) | (v & 1);
+					v >>= 1;
+				}
+				return ret;
+			}
+
+			template <typename Fn>
+			static size_t scanBucket(buckets_t* buckets, size_t index, Fn& fn) {
+				auto bucket = buckets->bucket(index);
+				if (bucket == nullptr)
+					return 0;
+
+				size_t visited = 0;
+				bucket->forEach([&fn, &visited](Value* value) {
+					++visited;
+					fn(value);
+				});
+				return visited;
+			}
+
 		public:
 			table():
 				sizingStrategy(),
@@ -134,19 +289,213 @@ namespace o1 {
 			 *                    of the bucket vector.
 			 */
 			explicit table(size_t maxElements):
-				sizingStrategy(O1_HASH_TABLE_DEFAULT_LOAD_EXPONENT, maxElements) {
+				sizingStrategy(O1_HASH_TABLE_DEFAULT_LOAD_EXPONENT, maxElements),
+				_elements(getElementsNode) {
+			}
+
+			/**
+			 * Fixed capacity table: the bucket vector, and all of its
+			 * buckets, are allocated here, for @param fixed.capacity
+			 * entries (at the current load factor); no other operation
+			 * allocates memory, and adding entries past the capacity
+			 * fails (see insert(), set() and find_or_insert()).
+			 *
+			 * The whole bucket vector is kept for the lifetime of the
+			 * table, however few entries it holds.
+			 */
+			explicit table(fixed_capacity fixed):
+				sizingStrategy(O1_HASH_TABLE_DEFAULT_LOAD_EXPONENT, fixed.capacity),
+				_elements(getElementsNode),
+				fixedCapacity(fixed.capacity) {
+				o1::xassert(fixedCapacity > 0, "o1::hash::table: fixed capacity must be positive");
+
+				size_t numBuckets;
+				sizing_strategy::bucketsSizing(
+					fixedCapacity,
+					sizingStrategy.loadExponent(),
+					sizingStrategy.maxSizingIndex(),
+					currentSlot,
+					numBuckets);
+
+				slots = new buckets_t*[sizingStrategy.maxSizingIndex() + 1]{nullptr};
+				slots[currentSlot] = new buckets_t(numBuckets);
+				slots[currentSlot]->preallocate();
+				_elements.reserve();
+			}
+
+			/**
+			 * Builds the table out of @param count @param values (see load()).
+			 */
+			table(Value* const* values, size_t count, unsigned numThreads = 0):
+				sizingStrategy(),
+				_elements(getElementsNode) {
+				load(values, count, numThreads);
 			}
 
 			~table() {
 				clear();
+				if (slots != nullptr)
+					toSmall();
+			}
+
+			/**
+			 * Bulk load, into an empty table: the bucket vector is sized
+			 * for @param count up front, and entries are hashed and linked
+			 * into their buckets by several threads, each one working on
+			 * its own range of buckets (so no locking is needed).
+			 *
+			 * ops functions get called concurrently, so they must be
+			 * thread safe.
+			 *
+			 * @param values entries to insert; if there are several with
+			 *        the same key, the first one is kept.
+			 * @param numThreads threads to use, 0 for one per hardware
+			 *        thread.
+			 * @return number of entries inserted.
+			 *
+			 * Fixed capacity tables get the entries inserted one at a time
+			 * (up to the capacity).
+			 */
+			size_t load(Value* const* values, size_t count, unsigned numThreads = 0) {
+				o1::xassert(empty(), "o1::hash::table::load: the table must be empty");
+
+				if (fixedCapacity != 0) {
+					for (size_t i = 0; i < count; ++i)
+						insert(values[i]);
+					return _elements.size();
+				}
+
+				clear();
+
+				size_t sizeIndex = 0;
+				while (
+					sizeIndex + 1 < sizingStrategy.maxSizingIndex() &&
+					count > sizingStrategy.maxElements(sizeIndex))
+				{
+					++sizeIndex;
+				}
+
+				currentSlot = sizeIndex;
+				slots = new buckets_t*[sizingStrategy.maxSizingIndex() + 1]{nullptr};
+				auto buckets = slots[currentSlot] = new buckets_t(sizingStrategy.numBuckets(currentSlot));
+				buckets->reserve();
+
+				if (count == 0)
+					return 0;
+
+				// small loads are not worth the threads.
+				const size_t minPerThread = 16384;
+				if (numThreads == 0)
+					numThreads = std::max(1u, std::thread::hardware_concurrency());
+				numThreads = std::max<size_t>(1, std::min<size_t>(numThreads, count / minPerThread));
+
+				const size_t numBuckets = buckets->numBuckets();
+				const size_t numRanges = std::min<size_t>(numBuckets, 8 * numThreads);
+
+				auto rangeOf = [numBuckets, numRanges](size_t bucket) {
+					return bucket * numRanges / numBuckets;
+				};
+
+				auto partOf = [count, numThreads](unsigned t, size_t& first, size_t& last) {
+					first = count * t / numThreads;
+					last = count * (t + 1) / numThreads;
+				};
+
+				// hash, and count entries per bucket range (per thread).
+				std::vector<hash_val> hashes(count);
+				std::vector<std::vector<size_t>> offsets(numThreads, std::vector<size_t>(numRanges, 0));
+
+				o1::hash::parallel(numThreads, [&](unsigned t) {
+					size_t first, last;
+					partOf(t, first, last);
+					for (size_t i = first; i < last; ++i) {
+						hashes[i] = ops->hashValue(ops->getKey(values[i]));
+						++offsets[t][rangeOf(hashes[i] % numBuckets)];
+					}
+				});
+
+				// stable counting sort by bucket range.
+				std::vector<size_t> rangeStart(numRanges + 1, 0);
+				size_t offset = 0;
+				for (size_t r = 0; r < numRanges; ++r) {
+					rangeStart[r] = offset;
+					for (unsigned t = 0; t < numThreads; ++t) {
+						size_t n = offsets[t][r];
+						offsets[t][r] = offset;
+						offset += n;
+					}
+				}
+				rangeStart[numRanges] = offset;
+
+				std::vector<size_t> order(count);
+
+				o1::hash::parallel(numThreads, [&](unsigned t) {
+					size_t first, last;
+					partOf(t, first, last);
+					for (size_t i = first; i < last; ++i)
+						order[offsets[t][rangeOf(hashes[i] % numBuckets)]++] = i;
+				});
+
+				// link the chains, one bucket range at a time.
+				std::vector<uint8_t> inserted(count, 0);
+				std::vector<size_t> allocated(numThreads, 0);
+				std::atomic<size_t> nextRange{0};
+
+				o1::hash::parallel(numThreads, [&](unsigned t) {
+					for (size_t r = nextRange++; r < numRanges; r = nextRange++) {
+						for (size_t k = rangeStart[r]; k < rangeStart[r + 1]; ++k) {
+							size_t i = order[k];
+							inserted[i] = buckets->insertAt(
+								hashes[i] % numBuckets,
+								ops->getKey(values[i]),
+								values[i],
+								allocated[t]);
+						}
+					}
+				});
+
+				for (auto n: allocated)
+					buckets->addNonNullBuckets(n);
+
+				for (size_t i = 0; i < count; ++i) {
+					if (inserted[i])
+						_elements.push_back(values[i]);
+				}
+
+				return _elements.size();
 			}
 
 			size_t size() const { return _elements.size(); }
 
 			bool empty() const { return _elements.empty(); }
 
+			/**
+			 * @return the capacity of a fixed capacity table, 0 for the
+			 *         others.
+			 */
+			size_t capacity() const { return fixedCapacity; }
+
+			/**
+			 * @return true if no entry can be added (fixed capacity tables
+			 *         only).
+			 */
+			bool full() const {
+				return fixedCapacity != 0 && _elements.size() >= fixedCapacity;
+			}
+
+			/**
+			 * @return false if the key was present, or the table is full.
+			 */
 			bool insert(Value* value) {
+				if (full())
+					return false;
 				auto key = ops->getKey(value);
+				if (small(true)) {
+					if (smallFind(key) != nullptr)
+						return false;
+					_elements.push_back(value);
+					return true;
+				}
 				hash_val hashValue = ops->hashValue(key);
 				rehash(hashValue);
 				auto retVal = getCurrentSlot()->insert(key, hashValue, value);
@@ -161,14 +510,34 @@ namespace o1 {
 			 * @param value
 			 * @param old_value if !nullptr, existing value (if any) is stored here.
 			 * @return true if the entry was not found and added.
+			 *         On a full table, it's only stored if it replaces an
+			 *         existing entry (and false is returned either way).
 			 */
 			bool set(Value* value, Value** old_value = nullptr) {
+				if (full()) {
+					replace(value, old_value);
+					return false;
+				}
+
+				Value* _old_value = nullptr;
 				auto key = ops->getKey(value);
+				if (small(true)) {
+					_old_value = smallFind(key);
+					if (_old_value != nullptr)
+						ops->getElementsNode(_old_value)->detach();
+					_elements.push_back(value);
+					if (old_value != nullptr)
+						*old_value = _old_value;
+					return _old_value == nullptr;
+				}
 				hash_val hashValue = ops->hashValue(key);
 				rehash(hashValue);
-				auto retVal = getCurrentSlot()->set(key, hashValue, value, old_value);
-				if (retVal)
-					_elements.push_back(value);
+				auto retVal = getCurrentSlot()->set(key, hashValue, value, &_old_value);
+				if (_old_value != nullptr)
+					ops->getElementsNode(_old_value)->detach();
+				_elements.push_back(value);
+				if (old_value != nullptr)
+					*old_value = _old_value;
 				return retVal;
 			}
 
@@ -181,9 +550,15 @@ namespace o1 {
 			bool replace(Value* value, Value** old_value = nullptr) {
 				Value* _old_value = nullptr;
 				auto key = ops->getKey(value);
-				hash_val hashValue = ops->hashValue(key);
-				rehash(hashValue);
-				auto retVal = getCurrentSlot()->replace(key, hashValue, value, &_old_value);
+				bool retVal;
+				if (small(false)) {
+					_old_value = smallFind(key);
+					retVal = _old_value != nullptr;
+				} else {
+					hash_val hashValue = ops->hashValue(key);
+					rehash(hashValue);
+					retVal = getCurrentSlot()->replace(key, hashValue, value, &_old_value);
+				}
 				if (retVal) {
 					ops->getElementsNode(_old_value)->detach();
 					_elements.push_back(value);
@@ -205,9 +580,15 @@ namespace o1 {
 
 			bool remove(const Key& key, Value** old_value = nullptr) {
 				Value* _old_value = nullptr;
-				hash_val hashValue = ops->hashValue(key);
-				rehash(hashValue);
-				auto retVal = getCurrentSlot()->remove(key, hashValue, &_old_value);
+				bool retVal;
+				if (small(false)) {
+					_old_value = smallFind(key);
+					retVal = _old_value != nullptr;
+				} else {
+					hash_val hashValue = ops->hashValue(key);
+					rehash(hashValue);
+					retVal = getCurrentSlot()->remove(key, hashValue, &_old_value);
+				}
 				if (retVal) {
 					ops->getElementsNode(_old_value)->detach();
 					if (old_value != nullptr)
@@ -217,21 +598,262 @@ namespace o1 {
 			}
 
 			Value* find(const Key& key) {
+				if (small(false))
+					return smallFind(key);
 				hash_val hashValue = ops->hashValue(key);
 				rehash(hashValue);
 				return getCurrentSlot()->find(key, hashValue);
 			}
 
 			/**
-			 * Remove all entries.
+			 * Looks @param key up and, if it's missing, inserts the entry
+			 * created by @param factory(); the key is hashed, and its chain
+			 * walked, only once.
+			 * @param factory called as factory() only on a miss; it must
+			 *        return a new entry with @param key (or nullptr, in
+			 *        which case nothing is inserted).
+			 * @param inserted if not a nullptr, set to whether the entry
+			 *        was created.
+			 * @return the entry found or created (nullptr if it's missing
+			 *         and the table is full: factory is not called).
+			 */
+			template <typename Factory>
+			Value* find_or_insert(const Key& key, Factory factory, bool* inserted = nullptr) {
+				bool _inserted = false;
+				Value* retVal;
+				if (full()) {
+					retVal = find(key);
+				} else if (small(true)) {
+					retVal = smallFind(key);
+					if (retVal == nullptr) {
+						retVal = factory();
+						_inserted = retVal != nullptr;
+						o1::xassert(!_inserted || ops->equal(key, ops->getKey(retVal)),
+							"o1::hash: find_or_insert factory created an entry with another key");
+					}
+				} else {
+					hash_val hashValue = ops->hashValue(key);
+					rehash(hashValue);
+					retVal = getCurrentSlot()->findOrInsert(key, hashValue, factory, _inserted);
+				}
+				if (_inserted)
+					_elements.push_back(retVal);
+				if (inserted != nullptr)
+					*inserted = _inserted;
+				return retVal;
+			}
+
+			/**
+			 * Calls @param update(Value*) on the entry of @param key, or
+			 * inserts the one created by @param factory() if there is none,
+			 * with a single lookup (see find_or_insert()).
+			 * @return the entry updated or created.
+			 */
+			template <typename Update, typename Factory>
+			Value* upsert(const Key& key, Update update, Factory factory) {
+				bool inserted = false;
+				auto retVal = find_or_insert(key, factory, &inserted);
+				if (retVal != nullptr && !inserted)
+					update(retVal);
+				return retVal;
+			}
+
+			/**
+			 * Looks up @param key w/out rehashing (nor moving any entry
+			 * between slots), so it does not modify the table: it can be
+			 * called concurrently with other peek() calls, as long as no
+			 * other operation runs at the same time.
+			 * @return the entry found, or nullptr.
+			 */
+			Value* peek(const Key& key) const {
+				return peek(key, ops->hashValue(key));
+			}
+
+			/**
+			 * peek() with an already computed @param hashValue.
+			 */
+			Value* peek(const Key& key, hash_val hashValue) const {
+				if (slots == nullptr)
+					return smallFind(key);
+
+				for (
+					size_t iSlot = 0;
+					iSlot <= sizingStrategy.maxSizingIndex();
+					++iSlot)
+				{
+					if (slots[iSlot] == nullptr)
+						continue;
+
+					if (auto found = slots[iSlot]->peek(key, hashValue))
+						return found;
+				}
+
+				return nullptr;
+			}
+
+			/**
+			 * Prefetches the bucket pointers of @param hashValue (in all
+			 * the slots), ahead of a peek().
+			 */
+			void prefetch(hash_val hashValue) const {
+				if (slots == nullptr)
+					return;
+
+				for (size_t iSlot = 0; iSlot <= sizingStrategy.maxSizingIndex(); ++iSlot) {
+					if (slots[iSlot] != nullptr)
+						slots[iSlot]->prefetch(hashValue);
+				}
+			}
+
+			/**
+			 * Visits all entries from @param numThreads threads, in chunks:
+			 * the buckets are split in ranges, and the entries of each
+			 * range are passed as fn(const std::vector<Value*>& chunk,
+			 * unsigned thread).  The table must not be modified meanwhile
+			 * (peek() is fine).
+			 */
+			template <typename Fn>
+			void for_each_chunk(unsigned numThreads, Fn fn) {
+				if (slots == nullptr) {
+					std::vector<Value*> chunk;
+					for (auto& value: _elements)
+						chunk.push_back(&value);
+					if (!chunk.empty())
+						fn(const_cast<const std::vector<Value*>&>(chunk), 0u);
+					return;
+				}
+
+				struct range {
+					buckets_t* buckets;
+					size_t first;
+					size_t last;
+				};
+
+				const size_t rangeSize = 1024;
+				std::vector<range> ranges;
+
+				for (size_t iSlot = 0; iSlot <= sizingStrategy.maxSizingIndex(); ++iSlot) {
+					auto buckets = slots[iSlot];
+					if (buckets == nullptr || buckets->empty())
+						continue;
+
+					for (size_t first = 0; first < buckets->numBuckets(); first += rangeSize)
+						ranges.push_back(range{buckets, first, std::min(first + rangeSize, buckets->numBuckets())});
+				}
+
+				numThreads = std::max<size_t>(1, std::min<size_t>(numThreads, ranges.size()));
+				std::atomic<size_t> next{0};
+
+				o1::hash::parallel(numThreads, [&](unsigned t) {
+					std::vector<Value*> chunk;
+					for (size_t r = next++; r < ranges.size(); r = next++) {
+						chunk.clear();
+						for (size_t i = ranges[r].first; i < ranges[r].last; ++i) {
+							if (auto bucket = ranges[r].buckets->bucket(i))
+								bucket->forEach([&chunk](Value* value) { chunk.push_back(value); });
+						}
+						if (!chunk.empty())
+							fn(const_cast<const std::vector<Value*>&>(chunk), t);
+					}
+				});
+			}
+
+			/**
+			 * Incremental iteration (as in Redis SCAN): start with cursor 0,
+			 * and keep calling scan() with the returned cursor until it
+			 * returns 0.
+			 *
+			 * Every element present during the whole scan is visited at
+			 * least once, even if the table grows, shrinks or migrates
+			 * buckets between calls; elements may be visited more than
+			 * once, and elements added or removed during the scan may or
+			 * may not be visited.
+			 *
+			 * Buckets are visited in reverse binary order of their index,
+			 * so that the buckets already visited in a smaller (or larger)
+			 * bucket vector are also the ones already visited in all of the
+			 * other ones.
+			 *
+			 * @param cursor 0 to start a scan, the returned value otherwise.
+			 * @param budget approximate number of elements to visit; at most
+			 *        10 * budget buckets are visited in a single call.
+			 * @param fn called as fn(Value*) for each element visited. It may
+			 *        detach (or delete) the element it got, but must not call
+			 *        any other method of this table.
+			 * @return cursor for the next call, 0 if the scan is complete.
+			 */
+			template <typename Fn>
+			size_t scan(size_t cursor, size_t budget, Fn fn) {
+				if (slots == nullptr) {
+					smallForEach(fn);
+					return 0;
+				}
+
+				size_t first = 0;
+				while (first <= sizingStrategy.maxSizingIndex() && slots[first] == nullptr)
+					++first;
+
+				if (first > sizingStrategy.maxSizingIndex())
+					return 0;
+
+				if (budget == 0)
+					budget = 1;
+
+				// smallest bucket vector.
+				const size_t m0 = slots[first]->numBuckets() - 1;
+				size_t visited = 0;
+				size_t steps = 0;
+
+				do {
+					visited += scanBucket(slots[first], cursor & m0, fn);
+
+					// all of the buckets in the larger vectors that expand
+					// this one.
+					for (
+						size_t iSlot = first + 1;
+						iSlot <= sizingStrategy.maxSizingIndex();
+						++iSlot)
+					{
+						if (slots[iSlot] == nullptr)
+							continue;
+
+						const size_t m1 = slots[iSlot]->numBuckets() - 1;
+						size_t v = cursor;
+						do {
+							visited += scanBucket(slots[iSlot], v & m1, fn);
+							v = (((v | m0) + 1) & ~m0) | (v & m0);
+						} while (v & (m0 ^ m1));
+					}
+
+					// increment the reversed cursor.
+					cursor |= ~m0;
+					cursor = reverseBits(cursor);
+					++cursor;
+					cursor = reverseBits(cursor);
+
+				} while (cursor != 0 && visited < budget && ++steps < 10 * budget);
+
+				return cursor;
+			}
+
+			/**
+			 * Remove all entries, NOT deleting them.
 			 */
 			void clear() {
-				for (int i = 0; i <= sizingStrategy.maxSizingIndex(); ++i) {
-					delete slots[i];
-					slots[i] = nullptr;
+				if (fixedCapacity != 0) {
+					// buckets are kept.
+					while (auto value = _elements.pop_front())
+						ops->getNode(value)->getBucketNode()->detach();
+					return;
 				}
-				delete[] slots;
-				currentSlot = 0;
+
+				while (_elements.pop_front());
+
+				delete spare;
+				spare = nullptr;
+
+				if (slots != nullptr)
+					toSmall();
 			}
 
 			const o1::hash::list_t<Value>&
@@ -241,6 +863,9 @@ namespace o1 {
 
 		};
 
+		template <typename Key, typename Value, struct ops<Key, Value>* ops>
+		const constexpr size_t table<Key, Value, ops>::smallSize;
+
 	}
 
 }
@@ -32,46 +32,17 @@
  */
 
 #include <gtest/gtest.h>
+#include <iterator>
+#include <algorithm>
+#include <set>
+#include <vector>
 #include "o1.hash.table_t.hh"
-#include "o1.hash.node_t.hh"
+#include "o1.hash.test_fixture.hh"
+#include "../../memory/o1.memory.allocations.test.hh"
 
 namespace {
 
-	struct HashNode {
-		int key;
-
-		mutable o1::hash::node_t<HashNode> hash_node;
-
-		explicit HashNode(int _key) : key(_key), hash_node(this) {}
-	};
-
-	using Key = decltype(HashNode::key);
-	using Value = HashNode;
-	using node_t = typename o1::hash::node_t<Value>;
-
-	o1::hash::hash_val hashFn(const Key& key) {
-		return o1::hash::hashValue(&key, sizeof(key), 0);
-	}
-
-	const Key getKey(const Value* value) {
-		return value->key;
-	}
-
-	node_t* getNode(Value* value) {
-		return &value->hash_node;
-	}
-
-	bool equalFn(const Key& left, const Key& right) {
-		return left == right;
-	}
-
-	o1::hash::ops<int, HashNode> _hash_ops{
-		.hashValue = hashFn,
-		.getKey = getKey,
-		.getNode = getNode,
-		.equal = equalFn
-	};
-
+	using namespace o1::hash::test;
 
 	TEST(o1_hash_table, basic_tests) {
 
@@ -135,4 +106,387 @@ namespace {
 		EXPECT_EQ(table.size(), 0);
 	}
 
-}
\ No newline at end of file
+	TEST(o1_hash_table, peek) {
+		o1::hash::table<Key, Value, &_hash_ops> table;
+		EXPECT_EQ(table.peek(1), nullptr);
+
+		HashNode* nodes[NODE_COUNT]{nullptr};
+
+		for (int i = 0; i < NODE_COUNT; ++i) {
+			nodes[i] = new HashNode(i);
+			table.insert(nodes[i]);
+		}
+
+		for (int i = 0; i < NODE_COUNT; ++i)
+			EXPECT_EQ(table.peek(i), nodes[i]) << "i=" << i;
+
+		EXPECT_EQ(table.peek(NODE_COUNT), nullptr);
+
+		for (auto& node: nodes)
+			delete node;
+
+		EXPECT_TRUE(table.empty());
+	}
+
+	TEST(o1_hash_table, scan) {
+		o1::hash::table<Key, Value, &_hash_ops> table;
+		std::set<int> seen;
+
+		EXPECT_EQ(table.scan(0, 10, [&seen](HashNode* node) { seen.insert(node->key); }), 0);
+
+		std::vector<HashNode*> nodes;
+		for (int i = 0; i < NODE_COUNT; ++i) {
+			nodes.push_back(new HashNode(i));
+			table.insert(nodes.back());
+		}
+
+		size_t cursor = 0;
+		size_t calls = 0;
+		do {
+			cursor = table.scan(cursor, 16, [&seen](HashNode* node) { seen.insert(node->key); });
+			++calls;
+		} while (cursor != 0);
+
+		EXPECT_EQ(seen.size(), NODE_COUNT);
+		EXPECT_GT(calls, 1);
+
+		for (auto node: nodes)
+			delete node;
+	}
+
+	TEST(o1_hash_table, scan_while_resizing) {
+		o1::hash::table<Key, Value, &_hash_ops> table;
+		const int stable = 300;
+		const int extra = 5000;
+		std::vector<HashNode*> nodes;
+		std::set<int> seen;
+
+		for (int i = 0; i < stable; ++i) {
+			nodes.push_back(new HashNode(i));
+			table.insert(nodes.back());
+		}
+
+		auto collect = [&seen](HashNode* node) { seen.insert(node->key); };
+
+		// grow (and migrate) between calls.
+		size_t cursor = table.scan(0, 8, collect);
+		for (int i = stable; i < stable + extra && cursor != 0; ++i) {
+			nodes.push_back(new HashNode(i));
+			table.insert(nodes.back());
+			if (i % 64 == 0)
+				cursor = table.scan(cursor, 8, collect);
+		}
+
+		// shrink (and migrate) between calls.
+		for (int i = stable; cursor != 0; ++i) {
+			if (i < static_cast<int>(nodes.size())) {
+				table.remove(nodes[i]);
+				table.find(i);
+			}
+			if (i % 64 == 0)
+				cursor = table.scan(cursor, 8, collect);
+		}
+
+		for (int i = 0; i < stable; ++i)
+			EXPECT_EQ(seen.count(i), 1) << "i=" << i;
+
+		for (auto node: nodes)
+			delete node;
+	}
+
+	TEST(o1_hash_table, scan_detach) {
+		o1::hash::table<Key, Value, &_hash_ops> table;
+
+		for (int i = 0; i < NODE_COUNT; ++i)
+			table.insert(new HashNode(i));
+
+		size_t cursor = 0;
+		int deleted = 0;
+		do {
+			cursor = table.scan(cursor, 32, [&deleted](HashNode* node) {
+				if (node->key % 2 == 0) {
+					delete node;
+					++deleted;
+				}
+			});
+		} while (cursor != 0);
+
+		EXPECT_EQ(deleted, (NODE_COUNT + 1) / 2);
+		EXPECT_EQ(table.size(), NODE_COUNT / 2);
+
+		for (int i = 0; i < NODE_COUNT; ++i) {
+			auto node = table.find(i);
+			EXPECT_EQ(node != nullptr, i % 2 == 1) << "i=" << i;
+			delete node;
+		}
+
+		EXPECT_TRUE(table.empty());
+	}
+
+	TEST(o1_hash_table, find_or_insert) {
+		o1::hash::table<Key, Value, &_hash_ops> table;
+		int created = 0;
+		auto factory = [&created]() { ++created; return new HashNode(7); };
+
+		bool inserted = false;
+		auto node = table.find_or_insert(7, factory, &inserted);
+		ASSERT_NE(node, nullptr);
+		EXPECT_TRUE(inserted);
+		EXPECT_EQ(created, 1);
+		EXPECT_EQ(table.size(), 1);
+
+		EXPECT_EQ(table.find_or_insert(7, factory, &inserted), node);
+		EXPECT_FALSE(inserted);
+		EXPECT_EQ(created, 1);
+
+		EXPECT_EQ(table.find_or_insert(8, []() -> HashNode* { return nullptr; }, &inserted), nullptr);
+		EXPECT_FALSE(inserted);
+		EXPECT_EQ(table.find(8), nullptr);
+		EXPECT_EQ(table.size(), 1);
+
+		delete node;
+	}
+
+	TEST(o1_hash_table, upsert) {
+		struct Counter: public HashNode {
+			int count{1};
+			explicit Counter(int key): HashNode(key) {}
+		};
+
+		o1::hash::table<Key, Value, &_hash_ops> table;
+
+		for (int i = 0; i < 3 * NODE_COUNT; ++i) {
+			int key = i % NODE_COUNT;
+			table.upsert(
+				key,
+				[](HashNode* node) { ++static_cast<Counter*>(node)->count; },
+				[key]() { return new Counter(key); }
+			);
+		}
+
+		EXPECT_EQ(table.size(), NODE_COUNT);
+
+		for (int i = 0; i < NODE_COUNT; ++i) {
+			auto node = static_cast<Counter*>(table.find(i));
+			ASSERT_NE(node, nullptr);
+			EXPECT_EQ(node->count, 3) << "i=" << i;
+			delete node;
+		}
+
+		EXPECT_TRUE(table.empty());
+	}
+
+	TEST(o1_hash_table, load) {
+		const int count = 200000;
+		std::vector<HashNode*> nodes;
+
+		for (int i = 0; i < count; ++i)
+			nodes.push_back(new HashNode(i));
+
+		// duplicates: the first one is kept.
+		nodes.push_back(new HashNode(10));
+		nodes.push_back(new HashNode(count - 1));
+
+		o1::hash::table<Key, Value, &_hash_ops> table(nodes.data(), nodes.size(), 4);
+
+		EXPECT_EQ(table.size(), count);
+
+		for (int i = 0; i < count; ++i)
+			ASSERT_EQ(table.find(i), nodes[i]) << "i=" << i;
+
+		// the table keeps working as usual.
+		HashNode extra{count};
+		EXPECT_TRUE(table.insert(&extra));
+		EXPECT_EQ(table.find(count), &extra);
+		EXPECT_TRUE(table.remove(&extra));
+
+		for (auto node: nodes)
+			delete node;
+
+		EXPECT_TRUE(table.empty());
+	}
+
+	TEST(o1_hash_table, load_small) {
+		o1::hash::table<Key, Value, &_hash_ops> table;
+		EXPECT_EQ(table.load(nullptr, 0), 0);
+
+		HashNode* nodes[] = {new HashNode(1), new HashNode(2), new HashNode(3)};
+		table.clear();
+		EXPECT_EQ(table.load(nodes, 3), 3);
+		EXPECT_EQ(table.find(2), nodes[1]);
+
+		for (auto node: nodes)
+			delete node;
+	}
+
+	struct small_table: o1::hash::table<Key, Value, &_hash_ops> {
+		bool hasBuckets() const { return slots != nullptr; }
+	};
+
+	TEST(o1_hash_table, small_mode) {
+		small_table table;
+		std::vector<HashNode*> nodes;
+		for (int i = 0; i < 16; ++i)
+			nodes.push_back(new HashNode(i));
+
+		EXPECT_EQ(table.find(0), nullptr);
+		EXPECT_FALSE(table.hasBuckets());
+
+		for (int i = 0; i < 7; ++i)
+			EXPECT_TRUE(table.insert(nodes[i]));
+		EXPECT_FALSE(table.insert(nodes[3]));
+		EXPECT_TRUE(table.insert(nodes[7]));
+		EXPECT_FALSE(table.hasBuckets());
+
+		for (int i = 0; i < 8; ++i) {
+			EXPECT_EQ(table.find(i), nodes[i]);
+			EXPECT_EQ(table.peek(i), nodes[i]);
+		}
+		EXPECT_EQ(table.find(8), nullptr);
+
+		std::set<int> seen;
+		EXPECT_EQ(table.scan(0, 1, [&seen](HashNode* node) { seen.insert(node->key); }), 0);
+		EXPECT_EQ(seen.size(), 8);
+
+		size_t chunked = 0;
+		table.for_each_chunk(4, [&chunked](const std::vector<HashNode*>& chunk, unsigned) {
+			chunked += chunk.size();
+		});
+		EXPECT_EQ(chunked, 8);
+
+		// grows out of small mode.
+		EXPECT_TRUE(table.insert(nodes[8]));
+		EXPECT_TRUE(table.hasBuckets());
+		for (int i = 0; i < 16; ++i)
+			EXPECT_EQ(table.find(i), i <= 8 ? nodes[i] : nullptr);
+
+		// and gets back to it.
+		for (int i = 0; i < 5; ++i)
+			EXPECT_TRUE(table.remove(i));
+		EXPECT_EQ(table.find(5), nodes[5]);
+		EXPECT_FALSE(table.hasBuckets());
+		EXPECT_EQ(table.size(), 4);
+
+		// destroyed entries leave the table.
+		delete nodes[8];
+		nodes[8] = nullptr;
+		EXPECT_EQ(table.find(8), nullptr);
+		EXPECT_EQ(table.size(), 3);
+
+		for (auto node: nodes)
+			delete node;
+		EXPECT_TRUE(table.empty());
+	}
+
+	TEST(o1_hash_table, small_mode_updates) {
+		small_table table;
+		HashNode a{1}, b{1}, c{1}, d{2};
+
+		EXPECT_FALSE(table.replace(&a));
+		EXPECT_TRUE(table.set(&a));
+
+		HashNode* old = nullptr;
+		EXPECT_FALSE(table.set(&b, &old));
+		EXPECT_EQ(old, &a);
+		EXPECT_TRUE(table.replace(&c, &old));
+		EXPECT_EQ(old, &b);
+		EXPECT_EQ(table.find(1), &c);
+		EXPECT_EQ(table.size(), 1);
+
+		bool inserted = false;
+		EXPECT_EQ(table.find_or_insert(2, [&d]() { return &d; }, &inserted), &d);
+		EXPECT_TRUE(inserted);
+		EXPECT_EQ(table.find_or_insert(2, []() { return nullptr; }, &inserted), &d);
+		EXPECT_FALSE(inserted);
+
+		EXPECT_TRUE(table.remove(1, &old));
+		EXPECT_EQ(old, &c);
+		EXPECT_EQ(table.size(), 1);
+		EXPECT_FALSE(table.hasBuckets());
+	}
+
+	TEST(o1_hash_table, fixed_capacity) {
+		const int capacity = 100;
+		std::vector<HashNode*> nodes;
+		for (int i = 0; i < 2 * capacity; ++i)
+			nodes.push_back(new HashNode(i));
+		HashNode other{5};
+
+		o1::hash::table<Key, Value, &_hash_ops> table(o1::hash::fixed_capacity{capacity});
+		EXPECT_EQ(table.capacity(), capacity);
+
+		size_t before = o1::memory::test::allocations();
+		int inserted = 0;
+		int found = 0;
+		bool created = true;
+		HashNode* old = nullptr;
+
+		for (auto node: nodes)
+			inserted += table.insert(node);
+		bool full = table.full();
+
+		for (int i = 0; i < 2 * capacity; ++i)
+			found += table.find(i) == nodes[i];
+
+		Value* missing = table.find_or_insert(capacity, []() -> HashNode* { return nullptr; }, &created);
+		bool setMissing = table.set(nodes[capacity], &old);
+		Value* oldMissing = old;
+		table.set(&other, &old);
+		Value* oldPresent = old;
+		Value* replaced = table.find(5);
+
+		for (int i = 0; i < capacity; i += 2)
+			table.remove(i);
+		for (int i = capacity; i < 2 * capacity; ++i)
+			inserted += table.insert(nodes[i]);
+
+		table.clear();
+		for (int i = 0; i < capacity; ++i)
+			inserted += table.insert(nodes[i]);
+
+		size_t after = o1::memory::test::allocations();
+
+		EXPECT_EQ(after, before);
+		EXPECT_TRUE(full);
+		EXPECT_EQ(inserted, capacity + capacity / 2 + capacity);
+		EXPECT_EQ(found, capacity);
+		EXPECT_EQ(missing, nullptr);
+		EXPECT_FALSE(created);
+		EXPECT_FALSE(setMissing);
+		EXPECT_EQ(oldMissing, nullptr);
+		EXPECT_EQ(oldPresent, nodes[5]);
+		EXPECT_EQ(replaced, &other);
+		EXPECT_EQ(table.size(), capacity);
+		table.clear();
+
+		// the hook does see the allocations of a growing table.
+		o1::hash::table<Key, Value, &_hash_ops> growing;
+		before = o1::memory::test::allocations();
+		for (auto node: nodes)
+			growing.insert(node);
+		EXPECT_GT(o1::memory::test::allocations(), before);
+
+		for (auto node: nodes)
+			delete node;
+		EXPECT_TRUE(growing.empty());
+	}
+
+	TEST(o1_hash_table, elements_iterators) {
+		o1::hash::table<Key, Value, &_hash_ops> table;
+		std::vector<HashNode*> nodes;
+		for (int i = 0; i < 100; ++i) {
+			nodes.push_back(new HashNode(i));
+			table.insert(nodes.back());
+		}
+
+		const auto& elements = table.elements();
+		EXPECT_EQ(std::distance(elements.begin(), elements.end()), 100);
+		EXPECT_EQ(std::count_if(elements.begin(), elements.end(), [](const HashNode& node) { return node.key % 10 == 0; }), 10);
+		auto found = std::find_if(elements.begin(), elements.end(), [](const HashNode& node) { return node.key == 42; });
+		EXPECT_EQ(found.get(), nodes[42]);
+
+		for (auto node: nodes)
+			delete node;
+	}
+
+}
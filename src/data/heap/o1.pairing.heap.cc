@@ -0,0 +1,179 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#include "o1.pairing.heap.hh"
+#include "../../o1.logging.hh"
+
+using o1::pairing::heap;
+using node = o1::pairing::heap::node;
+
+heap::~heap() {
+	flush();
+}
+
+void heap::flush() {
+	// children get spliced into the sibling chain being walked, no stack needed.
+	node* x = _root;
+	while (x != nullptr) {
+		if (node* child = x->_child) {
+			node* last = child;
+			while (last->_next != nullptr)
+				last = last->_next;
+			last->_next = x->_next;
+			x->_next = child;
+		}
+
+		node* next = x->_next;
+		reset(x);
+		x = next;
+	}
+
+	_root = nullptr;
+	_size = 0;
+}
+
+void heap::reset(node* n) {
+	n->_child = n->_next = n->_prev = nullptr;
+	n->_heap = nullptr;
+}
+
+node* heap::meld(node* a, node* b) {
+	if (less(b, a)) {
+		node* tmp = a;
+		a = b;
+		b = tmp;
+	}
+
+	b->_prev = a;
+	b->_next = a->_child;
+	if (a->_child != nullptr)
+		a->_child->_prev = b;
+	a->_child = b;
+	return a;
+}
+
+node* heap::mergePairs(node* first) {
+	if (first == nullptr)
+		return nullptr;
+
+	// first pass: meld pairs, left to right, stacking them up (on _next).
+	node* pairs = nullptr;
+	while (first != nullptr) {
+		node* a = first;
+		node* b = a->_next;
+		a->_prev = a->_next = nullptr;
+
+		if (b == nullptr) {
+			a->_next = pairs;
+			pairs = a;
+			break;
+		}
+
+		first = b->_next;
+		b->_prev = b->_next = nullptr;
+
+		node* melded = meld(a, b);
+		melded->_next = pairs;
+		pairs = melded;
+	}
+
+	// second pass: meld them right to left.
+	node* ret = pairs;
+	pairs = pairs->_next;
+	ret->_next = nullptr;
+
+	while (pairs != nullptr) {
+		node* next = pairs->_next;
+		pairs->_next = nullptr;
+		ret = meld(ret, pairs);
+		pairs = next;
+	}
+
+	return ret;
+}
+
+void heap::cut(node* n) {
+	if (n->_prev->_child == n)
+		n->_prev->_child = n->_next;
+	else
+		n->_prev->_next = n->_next;
+
+	if (n->_next != nullptr)
+		n->_next->_prev = n->_prev;
+
+	n->_next = n->_prev = nullptr;
+}
+
+void heap::push(node* n) {
+	o1::xassert(n->_heap == nullptr, "o1::pairing::heap::push: node is already on a heap");
+
+	n->_child = n->_next = n->_prev = nullptr;
+	n->_heap = this;
+	_root = _root == nullptr ? n : meld(_root, n);
+	++_size;
+}
+
+node* heap::pop() {
+	node* ret = _root;
+	if (ret != nullptr)
+		remove(ret);
+	return ret;
+}
+
+void heap::decreased(node* n) {
+	o1::xassert(n->_heap == this, "o1::pairing::heap::decreased: node is not on this heap");
+
+	if (n == _root)
+		return;
+
+	cut(n);
+	_root = meld(_root, n);
+}
+
+void heap::remove(node* n) {
+	o1::xassert(n->_heap == this, "o1::pairing::heap::remove: node is not on this heap");
+
+	node* subtree = mergePairs(n->_child);
+
+	if (n == _root) {
+		_root = subtree;
+	} else {
+		cut(n);
+		if (subtree != nullptr)
+			_root = meld(_root, subtree);
+	}
+
+	reset(n);
+	--_size;
+}
@@ -0,0 +1,152 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#ifndef O1CPPLIB_O1_PAIRING_HEAP_HH
+#define O1CPPLIB_O1_PAIRING_HEAP_HH
+
+#include <cstddef>
+#include "../node/o1.pairing.node.hh"
+
+namespace o1 {
+
+	namespace pairing {
+
+		/**
+		 * Untyped part of a pairing heap (see heap_t): melding and
+		 * cutting of nodes; the ordering comes from less().
+		 *
+		 * The node being removed never gets compared, so it's safe to
+		 * remove it from its destructor (its datum being gone already).
+		 *
+		 * Nodes point to their heap, so heaps can't be moved.
+		 */
+		class heap {
+		public:
+			using node = o1::pairing::node;
+
+		private:
+			friend node;
+
+			node* _root{nullptr};
+			size_t _size{0};
+
+			/**
+			 * @return the root of the heap made of roots @param a and
+			 *         @param b (their siblings links must be null).
+			 */
+			node* meld(node* a, node* b);
+
+			/**
+			 * Two pass pairing of the siblings starting at @param first.
+			 * @return the root of the resulting heap, nullptr if none.
+			 */
+			node* mergePairs(node* first);
+
+			/**
+			 * Unlinks @param n (and its subtree) from its parent and
+			 * siblings.
+			 */
+			static void cut(node* n);
+
+			static void reset(node* n);
+
+		protected:
+
+			/**
+			 * @return if @param a goes before @param b.
+			 */
+			virtual bool less(const node* a, const node* b) const = 0;
+
+		public:
+			heap() = default;
+
+			heap(const heap& that) = delete;
+
+			heap(heap&& that) = delete;
+
+			/**
+			 * Upon destruction, nodes are NOT deleted, just unlinked.
+			 */
+			virtual ~heap();
+
+			/**
+			 * Remove all nodes from the heap, NOT deleting them.
+			 * O(n).
+			 */
+			void flush();
+
+			[[nodiscard]] inline size_t size() const { return _size; }
+
+			[[nodiscard]] inline bool empty() const { return _root == nullptr; }
+
+			/**
+			 * @return the minimum node, nullptr if the heap is empty.
+			 */
+			[[nodiscard]] inline node* top() { return _root; }
+
+			[[nodiscard]] inline const node* top() const { return _root; }
+
+			/**
+			 * Adds @param n.
+			 * O(1).
+			 */
+			void push(node* n);
+
+			/**
+			 * Removes (and returns) the minimum node.
+			 * O(log n) amortized.
+			 * @return the removed node, nullptr if the heap is empty.
+			 */
+			node* pop();
+
+			/**
+			 * Restores the heap order after the key of @param n got
+			 * decreased (it must not have increased).
+			 * O(1).
+			 */
+			void decreased(node* n);
+
+			/**
+			 * Removes @param n (which must be on this heap).
+			 * O(log n) amortized.
+			 */
+			void remove(node* n);
+
+		};
+
+	}
+
+}
+
+#endif //O1CPPLIB_O1_PAIRING_HEAP_HH
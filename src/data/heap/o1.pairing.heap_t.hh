@@ -0,0 +1,184 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#ifndef O1CPPLIB_O1_PAIRING_HEAP_T_HH
+#define O1CPPLIB_O1_PAIRING_HEAP_T_HH
+
+#include <functional>
+#include "./o1.pairing.heap.hh"
+#include "../node/o1.pairing.node_t.hh"
+#include "../../o1.debug.hh"
+#include "../../o1.logging.hh"
+
+namespace o1 {
+
+	namespace pairing {
+
+		/**
+		 * Intrusive priority queue: a pairing heap of T, each one
+		 * embedding a pairing::node_t<T>.
+		 *
+		 * - push, top, decrease_key: O(1);
+		 * - pop, remove, update: O(log n) amortized.
+		 *
+		 * Nothing is allocated, and destroying an element removes it.
+		 *
+		 * @tparam Less strict weak ordering of T: top() is the least.
+		 */
+		template <typename T, typename Less = std::less<T>>
+		class heap_t: public o1::pairing::heap {
+
+		public:
+
+			using node_t = o1::pairing::node_t<T>;
+			using getNodeFn = typename o1::pairing::node_t<T>::getNodeFn;
+
+		private:
+			getNodeFn getNode{nullptr};
+			Less _less;
+
+			static inline const T& datum(const node* node) {
+				return *static_cast<const node_t*>(node)->ref();
+			}
+
+		protected:
+
+			bool less(const node* a, const node* b) const override {
+				return _less(datum(a), datum(b));
+			}
+
+		public:
+
+			heap_t() = delete;
+
+			explicit heap_t(getNodeFn _getNode, Less less = Less()):
+				getNode(_getNode),
+				_less(less) {
+			}
+
+			heap_t(const heap_t& that) = delete;
+
+			heap_t(heap_t&& that) = delete;
+
+			~heap_t() override = default;
+
+			/**
+			 * Remove all elements from the heap, deleting them.
+			 */
+			void clear() {
+				while (auto element = pop())
+					delete element;
+			}
+
+			/**
+			 * Adds @param datum.
+			 * O(1).
+			 */
+			void push(T* datum) {
+				heap::push(getNode(datum));
+			}
+
+			/**
+			 * @return the least element, nullptr if the heap is empty.
+			 */
+			T* top() {
+				return node_t::ref(static_cast<node_t*>(heap::top()));
+			}
+
+			/**
+			 * Removes (and returns) the least element.
+			 * O(log n) amortized.
+			 * @return the removed element, nullptr if the heap is empty.
+			 */
+			T* pop() {
+				return node_t::ref(static_cast<node_t*>(heap::pop()));
+			}
+
+			/**
+			 * To be called after the key of @param datum got decreased.
+			 * O(1).
+			 */
+			void decrease_key(T* datum) {
+				node* node = getNode(datum);
+				o1::xassert(
+					node->owner() == this,
+					"o1::pairing::heap_t::decrease_key: element is not on this heap"
+				);
+				heap::decreased(node);
+			}
+
+			/**
+			 * To be called after the key of @param datum changed, either
+			 * way.
+			 * O(log n) amortized.
+			 */
+			void update(T* datum) {
+				node* node = getNode(datum);
+				o1::xassert(
+					node->owner() == this,
+					"o1::pairing::heap_t::update: element is not on this heap"
+				);
+				heap::remove(node);
+				heap::push(node);
+			}
+
+			/**
+			 * Removes @param datum, NOT deleting it (nothing is done if
+			 * it's on no heap).
+			 * O(log n) amortized.
+			 */
+			void remove(T* datum) {
+				node* node = getNode(datum);
+				if (o1::flags::extended_checks()) {
+					o1::xassert(
+						node->owner() == this || !node->linked(),
+						"o1::pairing::heap_t::remove: element is on another heap"
+					);
+				}
+				node->detach();
+			}
+
+		};
+
+	}
+
+	/**
+	 * Intrusive priority queue, see pairing::heap_t.
+	 */
+	template <typename T, typename Less = std::less<T>>
+	using heap = o1::pairing::heap_t<T, Less>;
+
+}
+
+#endif //O1CPPLIB_O1_PAIRING_HEAP_T_HH
@@ -0,0 +1,260 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "o1.pairing.heap_t.hh"
+#include "../o1.ordered.test_fixture.hh"
+#include "../../memory/o1.memory.allocations.test.hh"
+
+namespace {
+
+	template <typename T>
+	using pairing_node = o1::pairing::node_t<T>;
+
+	using Item = o1::test::item<pairing_node>;
+	using heap = o1::heap<Item, o1::test::ByKey>;
+
+	std::vector<int> drain(heap& heap) {
+		std::vector<int> ret;
+		while (auto item = heap.pop())
+			ret.push_back(item->key);
+		return ret;
+	}
+
+	enum class position { root, inner, leaf };
+
+	/**
+	 * Heap of random keys, shaped by a few pops (which pair subtrees
+	 * up), and the keys it holds, in reference.
+	 */
+	struct shaped {
+		std::vector<Item> items;
+		heap values{Item::getNode};
+		std::vector<int> reference;
+
+		explicit shaped(unsigned seed): items(300) {
+			std::mt19937 random(seed);
+			for (auto& item: items) {
+				item.key = int(random() % 1000);
+				reference.push_back(item.key);
+				values.push(&item);
+			}
+			for (int i = 0; i < 20; ++i)
+				values.push(values.pop());
+		}
+
+		/**
+		 * @return an element at @param where in the heap.
+		 */
+		Item* at(position where) {
+			if (where == position::root)
+				return values.top();
+
+			for (auto& item: items) {
+				if (&item == values.top())
+					continue;
+				if ((item.node.child() == nullptr) == (where == position::leaf))
+					return &item;
+			}
+			return nullptr;
+		}
+
+		/**
+		 * @return the sorted reference keys.
+		 */
+		std::vector<int> expected() const {
+			auto ret = reference;
+			std::sort(ret.begin(), ret.end());
+			return ret;
+		}
+	};
+
+	TEST(o1_heap, Constructor) {
+		heap heap(Item::getNode);
+		EXPECT_TRUE(heap.empty());
+		EXPECT_EQ(heap.size(), 0);
+		EXPECT_EQ(heap.top(), nullptr);
+		EXPECT_EQ(heap.pop(), nullptr);
+	}
+
+	TEST(o1_heap, PushPop) {
+		heap heap(Item::getNode);
+		std::vector<Item> items(1000);
+		std::vector<int> expected;
+		std::mt19937 random(3);
+
+		for (auto& item: items) {
+			item.key = int(random() % 300);
+			expected.push_back(item.key);
+			heap.push(&item);
+		}
+
+		std::sort(expected.begin(), expected.end());
+		EXPECT_EQ(heap.size(), items.size());
+		EXPECT_EQ(heap.top()->key, expected.front());
+		EXPECT_EQ(drain(heap), expected);
+		EXPECT_TRUE(heap.empty());
+
+		for (auto& item: items)
+			EXPECT_FALSE(item.node.linked());
+	}
+
+	TEST(o1_heap, Shape) {
+		shaped shaped(1);
+		EXPECT_EQ(shaped.values.top()->node.prev(), nullptr);
+		EXPECT_NE(shaped.at(position::inner), nullptr);
+		EXPECT_NE(shaped.at(position::leaf), nullptr);
+	}
+
+	TEST(o1_heap, DecreaseKey) {
+		for (auto where: { position::root, position::inner, position::leaf }) {
+			for (int delta: { 1, 2000 }) {
+				shaped shaped(11);
+				Item* item = shaped.at(where);
+				ASSERT_NE(item, nullptr);
+
+				*std::find(shaped.reference.begin(), shaped.reference.end(), item->key) -= delta;
+				item->key -= delta;
+				shaped.values.decrease_key(item);
+
+				auto expected = shaped.expected();
+				EXPECT_EQ(shaped.values.top()->key, expected.front()) << "delta=" << delta;
+				if (delta > 1000)
+					EXPECT_EQ(shaped.values.top(), item);
+				EXPECT_EQ(drain(shaped.values), expected) << "delta=" << delta;
+			}
+		}
+	}
+
+	TEST(o1_heap, Remove) {
+		for (auto where: { position::root, position::inner, position::leaf }) {
+			shaped shaped(13);
+			Item* item = shaped.at(where);
+			ASSERT_NE(item, nullptr);
+
+			shaped.reference.erase(std::find(shaped.reference.begin(), shaped.reference.end(), item->key));
+			shaped.values.remove(item);
+			EXPECT_FALSE(item->node.linked());
+			EXPECT_EQ(item->node.child(), nullptr);
+			EXPECT_EQ(shaped.values.size(), shaped.reference.size());
+			EXPECT_EQ(drain(shaped.values), shaped.expected());
+		}
+	}
+
+	TEST(o1_heap, Update) {
+		for (auto where: { position::root, position::inner, position::leaf }) {
+			shaped shaped(17);
+			Item* item = shaped.at(where);
+			ASSERT_NE(item, nullptr);
+
+			// increased keys need update(), not decrease_key().
+			*std::find(shaped.reference.begin(), shaped.reference.end(), item->key) += 5000;
+			item->key += 5000;
+			shaped.values.update(item);
+
+			auto result = drain(shaped.values);
+			EXPECT_EQ(result, shaped.expected());
+			EXPECT_EQ(result.back(), item->key);
+		}
+	}
+
+	TEST(o1_heap, RemoveUnlinked) {
+		heap heap(Item::getNode);
+		Item a{1}, b{2}, outsider{0};
+		heap.push(&a);
+		heap.push(&b);
+
+		heap.remove(&outsider);
+		EXPECT_FALSE(outsider.node.linked());
+		EXPECT_EQ(heap.size(), 2);
+
+		heap.remove(&a);
+		heap.remove(&a);
+		EXPECT_EQ(heap.size(), 1);
+		EXPECT_EQ(drain(heap), (std::vector<int>{2}));
+		EXPECT_EQ(heap.size(), 0);
+	}
+
+	TEST(o1_heap, DestroyedElementsGetRemoved) {
+		heap heap(Item::getNode);
+		Item a(1), c(3);
+		heap.push(&a);
+		heap.push(&c);
+		{
+			Item b(0);
+			heap.push(&b);
+			EXPECT_EQ(heap.top(), &b);
+		}
+		EXPECT_EQ(heap.size(), 2);
+		EXPECT_EQ(heap.top(), &a);
+		EXPECT_EQ(drain(heap), std::vector<int>({1, 3}));
+	}
+
+	TEST(o1_heap, ElementsOutliveHeap) {
+		std::vector<Item> items(20);
+		{
+			heap heap(Item::getNode);
+			for (int i = 0; i < 20; ++i) {
+				items[i].key = i % 7;
+				heap.push(&items[i]);
+			}
+			heap.push(heap.pop());
+		}
+		for (auto& item: items)
+			EXPECT_FALSE(item.node.linked());
+	}
+
+	TEST(o1_heap, NoAllocations) {
+		std::vector<Item> items(100);
+		heap heap(Item::getNode);
+
+		size_t before = o1::memory::test::allocations();
+
+		for (int i = 0; i < 100; ++i) {
+			items[i].key = (i * 37) % 100;
+			heap.push(&items[i]);
+		}
+		for (int i = 0; i < 50; ++i)
+			heap.pop();
+		heap.flush();
+
+		size_t after = o1::memory::test::allocations();
+
+		EXPECT_EQ(after, before);
+	}
+
+}
@@ -35,39 +35,81 @@
 #ifndef O1CPPLIB_O1_FORWARD_ITERATOR_REF_HH
 #define O1CPPLIB_O1_FORWARD_ITERATOR_REF_HH
 
-#include <algorithm>
 #include "./o1.iterator_ref.hh"
 
 namespace o1 {
 
+	/**
+	 * Walks nodes from first to last (next()).
+	 */
 	template <typename Node, typename Ref>
 	class forward_iterator_ref: public o1::iterator_ref<Node,Ref> {
+		const void* _finish{nullptr};
+
+		inline void moveTo(decltype(std::declval<Node*>()->next()) node) {
+			this->_node = node == _finish ? nullptr : static_cast<Node*>(node);
+		}
+
 	public:
-		explicit forward_iterator_ref(Node* node): o1::iterator_ref<Node,Ref>(node) { }
+		forward_iterator_ref() = default;
 
-		forward_iterator_ref(const forward_iterator_ref<Node,Ref>& that) = default;
+		/**
+		 * @param finish the node that ends the traversal (the list
+		 *        sentinel), nullptr for null terminated lists; it is
+		 *        never cast to Node.
+		 */
+		explicit forward_iterator_ref(Node* node, const void* finish = nullptr):
+			o1::iterator_ref<Node,Ref>(node),
+			_finish(finish) {
+		}
 
-		forward_iterator_ref(forward_iterator_ref<Node,Ref>&& that) noexcept :
-			o1::iterator_ref<Node,Ref>(std::move(that)) {
+		/**
+		 * Iterators convert to their const counterpart.
+		 */
+		template <
+			typename N,
+			typename R,
+			typename = typename std::enable_if<std::is_convertible<N*, Node*>::value>::type
+		>
+		forward_iterator_ref(const forward_iterator_ref<N,R>& that): // NOLINT(google-explicit-constructor)
+			o1::iterator_ref<Node,Ref>(that.node()),
+			_finish(that.finish()) {
 		}
 
-		bool operator == (const forward_iterator_ref<Node,Ref>& that) const {
-			return
-				*static_cast<const o1::iterator_ref<Node,Ref>*>(this) ==
-				static_cast<const o1::iterator_ref<Node,Ref>&>(that);
+		[[nodiscard]] inline const void* finish() const { return _finish; }
+
+		// prefix
+		forward_iterator_ref<Node,Ref>& operator++() {
+			if (this->_node != nullptr)
+				moveTo(this->_node->next());
+			return *this;
 		}
 
-		bool operator != (const forward_iterator_ref<Node,Ref>& that) const {
-			return
-				*static_cast<const o1::iterator_ref<Node,Ref>*>(this) !=
-				static_cast<const o1::iterator_ref<Node,Ref>&>(that);
+		// postfix
+		forward_iterator_ref<Node,Ref> operator++(int) {
+			forward_iterator_ref<Node,Ref> ret(*this);
+			++*this;
+			return ret;
 		}
 
-		// prefix
-		forward_iterator_ref<Node,Ref> operator++() {
+		/**
+		 * Only for nodes with prev(); from the end iterator, it needs a
+		 * finish node (so not on null terminated lists).
+		 */
+		forward_iterator_ref<Node,Ref>& operator--() {
+			using link = decltype(std::declval<Node*>()->prev());
 			if (this->_node != nullptr)
-				this->_node = dynamic_cast<Node*>(this->_node->next());
-			return forward_iterator_ref<Node,Ref>(this->_node);
+				moveTo(this->_node->prev());
+			else
+				moveTo(static_cast<link>(const_cast<void*>(_finish))->prev());
+			return *this;
+		}
+
+		// postfix
+		forward_iterator_ref<Node,Ref> operator--(int) {
+			forward_iterator_ref<Node,Ref> ret(*this);
+			--*this;
+			return ret;
 		}
 
 	};
@@ -35,32 +35,67 @@
 #ifndef O1CPPLIB_O1_ITERATOR_REF_HH
 #define O1CPPLIB_O1_ITERATOR_REF_HH
 
+#include <cstddef>
+#include <iterator>
 #include <type_traits>
+#include <utility>
 
 namespace o1 {
 
+	/**
+	 * std::bidirectional_iterator_tag for nodes with prev(),
+	 * std::forward_iterator_tag otherwise.
+	 */
+	template <typename Node>
+	class node_iterator_category {
+		template <typename N>
+		static std::bidirectional_iterator_tag test(decltype(std::declval<N*>()->prev())*);
+
+		template <typename N>
+		static std::forward_iterator_tag test(...);
+
+	public:
+		using type = decltype(test<Node>(nullptr));
+	};
+
+	/**
+	 * Iterator over (typed) nodes, dereferencing to the datum they
+	 * point to (Ref&); Ref is const T on const iterators (and Node is
+	 * const too).
+	 *
+	 * The end iterator holds a null node.
+	 */
 	template <typename Node, typename Ref>
 	class iterator_ref {
 	protected:
 		Node* _node{nullptr};
 
 	public:
+		using iterator_category = typename node_iterator_category<Node>::type;
+		using value_type = typename std::remove_const<Ref>::type;
+		using difference_type = std::ptrdiff_t;
+		using pointer = Ref*;
+		using reference = Ref&;
+
+		iterator_ref() = default;
+
 		explicit iterator_ref(Node* node): _node(node) {}
 
-		iterator_ref(const iterator_ref<Node, Ref>& that) = default;
+		[[nodiscard]] reference operator*() const { return *_node->ref(); }
 
-		iterator_ref(iterator_ref<Node, Ref>&& that) noexcept :
-			_node(that._node) {
-			that._node = nullptr;
-		}
+		[[nodiscard]] pointer operator->() const { return _node->ref(); }
 
-		[[nodiscard]] Ref* operator*() {
+		/**
+		 * @return the datum, nullptr on the end iterator.
+		 */
+		[[nodiscard]] pointer get() const {
 			return _node == nullptr ? nullptr : _node->ref();
 		}
 
-		[[nodiscard]] inline const Ref* operator*() const {
-			return _node == nullptr ? nullptr : _node->ref();
-		}
+		/**
+		 * @return the current node, nullptr on the end iterator.
+		 */
+		[[nodiscard]] inline Node* node() const { return _node; }
 
 		bool operator == (const iterator_ref<Node,Ref>& that) const {
 			return _node == that._node;
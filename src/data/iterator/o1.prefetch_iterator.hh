@@ -0,0 +1,173 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#ifndef O1CPPLIB_O1_PREFETCH_ITERATOR_HH
+#define O1CPPLIB_O1_PREFETCH_ITERATOR_HH
+
+#include <cstddef>
+#include <iterator>
+
+namespace o1 {
+
+	/**
+	 * Forward iterator adaptor over node iterators (forward_iterator_ref
+	 * & co.), keeping a second iterator @a distance hops ahead and
+	 * issuing software prefetches for the node it lands on (and for
+	 * the datum it refers to, if @a payload).
+	 *
+	 * Walking a chain is still one dependent load per hop: what gets
+	 * hidden is the latency of the nodes (and data) the caller is about
+	 * to touch, behind the work done on the current one.
+	 */
+	template <typename Iterator>
+	class prefetch_iterator {
+		Iterator _current;
+		Iterator _ahead;
+		Iterator _end;
+		bool _payload{true};
+
+		inline void prefetch() const {
+			if (_ahead == _end)
+				return;
+			__builtin_prefetch(_ahead.node());
+			if (_payload)
+				__builtin_prefetch(_ahead.get());
+		}
+
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = typename std::iterator_traits<Iterator>::value_type;
+		using difference_type = typename std::iterator_traits<Iterator>::difference_type;
+		using pointer = typename std::iterator_traits<Iterator>::pointer;
+		using reference = typename std::iterator_traits<Iterator>::reference;
+
+		prefetch_iterator() = default;
+
+		/**
+		 * @param end where the traversal ends (the lead iterator stops
+		 *        there).
+		 * @param distance hops between the current node and the
+		 *        prefetched one.
+		 * @param payload whether to prefetch the data too.
+		 */
+		prefetch_iterator(Iterator current, Iterator end, size_t distance, bool payload = true):
+			_current(current),
+			_ahead(current),
+			_end(end),
+			_payload(payload) {
+			for (; distance > 0 && _ahead != _end; --distance) {
+				++_ahead;
+				prefetch();
+			}
+		}
+
+		[[nodiscard]] reference operator*() const { return *_current; }
+
+		[[nodiscard]] pointer operator->() const { return _current.get(); }
+
+		/**
+		 * @return the datum, nullptr on the end iterator.
+		 */
+		[[nodiscard]] pointer get() const { return _current.get(); }
+
+		[[nodiscard]] const Iterator& base() const { return _current; }
+
+		// prefix
+		prefetch_iterator& operator++() {
+			++_current;
+			if (_ahead != _end) {
+				++_ahead;
+				prefetch();
+			}
+			return *this;
+		}
+
+		// postfix
+		prefetch_iterator operator++(int) {
+			prefetch_iterator ret(*this);
+			++*this;
+			return ret;
+		}
+
+		bool operator == (const prefetch_iterator& that) const {
+			return _current == that._current;
+		}
+
+		bool operator != (const prefetch_iterator& that) const {
+			return _current != that._current;
+		}
+
+	};
+
+	/**
+	 * @return a prefetch_iterator over @param container, from begin().
+	 */
+	template <typename Container>
+	auto prefetch_begin(Container& container, size_t distance, bool payload = true)
+		-> prefetch_iterator<decltype(container.begin())> {
+		return prefetch_iterator<decltype(container.begin())>(
+			container.begin(), container.end(), distance, payload
+		);
+	}
+
+	/**
+	 * @return the end prefetch_iterator of @param container.
+	 */
+	template <typename Container>
+	auto prefetch_end(Container& container)
+		-> prefetch_iterator<decltype(container.end())> {
+		return prefetch_iterator<decltype(container.end())>(
+			container.end(), container.end(), 0, false
+		);
+	}
+
+	/**
+	 * Calls @param fn(T*) on each element of @param container,
+	 * prefetching @param distance nodes ahead (and their data, if
+	 * @param payload).
+	 * @param fn may detach the element it got, but no other one.
+	 */
+	template <typename Container, typename Fn>
+	void for_each_prefetch(Container& container, size_t distance, Fn fn, bool payload = true) {
+		auto end = prefetch_end(container);
+		for (auto i = prefetch_begin(container, distance, payload); i != end;) {
+			auto datum = i.get();
+			++i;
+			fn(datum);
+		}
+	}
+
+}
+
+#endif //O1CPPLIB_O1_PREFETCH_ITERATOR_HH
@@ -0,0 +1,159 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "o1.prefetch_iterator.hh"
+#include "../list/o1.d_linked.list_t.hh"
+#include "../list/o1.s_linked.list_t.hh"
+
+namespace {
+
+	struct Item {
+		int value{};
+		o1::d_linked::node_t<Item> node{this};
+		o1::s_linked::node_t<Item> s_node{this};
+		char payload[64]{};
+	};
+
+	o1::d_linked::node_t<Item>* getNode(Item* item) {
+		return &item->node;
+	}
+
+	o1::s_linked::node_t<Item>* getSNode(Item* item) {
+		return &item->s_node;
+	}
+
+	using list_t = o1::d_linked::list_t<Item>;
+
+	TEST(o1_prefetch_iterator, SameSequence) {
+		list_t list(getNode);
+		std::vector<Item> items(20);
+		for (int i = 0; i < 20; ++i) {
+			items[i].value = i;
+			list.push_back(&items[i]);
+		}
+
+		for (size_t distance: {0, 1, 4, 19, 20, 100}) {
+			std::vector<int> seen;
+			for (auto i = o1::prefetch_begin(list, distance); i != o1::prefetch_end(list); ++i)
+				seen.push_back(i->value);
+			EXPECT_EQ(seen.size(), items.size()) << "distance=" << distance;
+			EXPECT_TRUE(std::is_sorted(seen.begin(), seen.end()));
+		}
+
+		list_t empty(getNode);
+		EXPECT_TRUE(o1::prefetch_begin(empty, 4) == o1::prefetch_end(empty));
+	}
+
+	TEST(o1_prefetch_iterator, StdAlgorithms) {
+		o1::s_linked::list_t<Item> list(getSNode);
+		std::vector<Item> items(10);
+		for (int i = 0; i < 10; ++i) {
+			items[i].value = i;
+			list.push_back(&items[i]);
+		}
+
+		auto found = std::find_if(
+			o1::prefetch_begin(list, 3, false),
+			o1::prefetch_end(list),
+			[](const Item& item) { return item.value == 6; }
+		);
+		EXPECT_EQ(found.get(), &items[6]);
+	}
+
+	TEST(o1_prefetch_iterator, ForEachMayDetachCurrent) {
+		list_t list(getNode);
+		std::vector<Item> items(10);
+		for (int i = 0; i < 10; ++i) {
+			items[i].value = i;
+			list.push_back(&items[i]);
+		}
+
+		int visited = 0;
+		o1::for_each_prefetch(list, 2, [&visited](Item* item) {
+			++visited;
+			if (item->value % 2 == 0)
+				item->node.detach();
+		});
+
+		EXPECT_EQ(visited, 10);
+		EXPECT_EQ(list.size(), 5);
+	}
+
+	/**
+	 * Walks a list (far) larger than the last level cache, nodes
+	 * linked in random memory order, with and without prefetching.
+	 */
+	TEST(o1_prefetch_iterator, DISABLED_Benchmark) {
+		const size_t count = 4 << 20;
+		std::vector<Item> items(count);
+		std::vector<size_t> order(count);
+		for (size_t i = 0; i < count; ++i)
+			order[i] = i;
+		std::shuffle(order.begin(), order.end(), std::mt19937(7));
+
+		list_t list(getNode);
+		for (auto i: order) {
+			items[i].value = int(i);
+			list.push_back(&items[i]);
+		}
+
+		auto measure = [&list](const char* name, size_t distance) {
+			long sum = 0;
+			auto start = std::chrono::steady_clock::now();
+			if (distance == 0) {
+				for (auto& item: list)
+					sum += item.value + item.payload[32];
+			} else {
+				o1::for_each_prefetch(list, distance, [&sum](Item* item) {
+					sum += item->value + item->payload[32];
+				});
+			}
+			auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+				std::chrono::steady_clock::now() - start
+			);
+			std::cout << name << ": " << elapsed.count() << "ms (" << sum << ")\n";
+		};
+
+		measure("plain", 0);
+		for (size_t distance: {1, 2, 4, 8, 16})
+			measure(("prefetch " + std::to_string(distance)).c_str(), distance);
+	}
+
+}
@@ -0,0 +1,276 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#ifndef O1CPPLIB_O1_D_LINKED_COMPACT_HOOK_LIST_HH
+#define O1CPPLIB_O1_D_LINKED_COMPACT_HOOK_LIST_HH
+
+#include <cstddef>
+#include <iterator>
+#include "../node/o1.container_of.hh"
+#include "../node/o1.d_linked.compact_hook.hh"
+
+namespace o1 {
+
+	namespace d_linked {
+
+		/**
+		 * Double linked list of T objects, linked through their
+		 * @tparam member compact_hook: 8 bytes per entry, a quarter of a
+		 * d_linked::node_t and half of a hook.
+		 *
+		 * Hooks only hold offsets, so the list is not circular: it keeps
+		 * (full) pointers to its first and last hooks, and may live
+		 * anywhere (ie: on the stack), while its entries must be close to
+		 * each other (see compact_hook).
+		 *
+		 * Upon destruction, remaining entries are unlinked (NOT deleted).
+		 */
+		template <typename T, compact_hook T::*member>
+		class compact_hook_list {
+
+			compact_hook* _first{nullptr};
+			compact_hook* _last{nullptr};
+			size_t _size{0};
+
+			static inline compact_hook* hookOf(T* datum) {
+				return &(datum->*member);
+			}
+
+			static inline T* datumOf(compact_hook* hook) {
+				return o1::container_of(hook, member);
+			}
+
+			/**
+			 * Inserts @param hook before @param at (nullptr: at the end).
+			 */
+			void linkBefore(compact_hook* hook, compact_hook* at) {
+				compact_hook* prev = at == nullptr ? _last : at->prev();
+
+				hook->setNext(at);
+				hook->setPrev(prev);
+
+				if (prev == nullptr)
+					_first = hook;
+				else
+					prev->setNext(hook);
+
+				if (at == nullptr)
+					_last = hook;
+				else
+					at->setPrev(hook);
+
+				++_size;
+			}
+
+			T* unlinkAndGet(compact_hook* hook) {
+				if (hook == nullptr)
+					return nullptr;
+
+				compact_hook* next = hook->next();
+				compact_hook* prev = hook->prev();
+
+				if (prev == nullptr)
+					_first = next;
+				else
+					prev->setNext(next);
+
+				if (next == nullptr)
+					_last = prev;
+				else
+					next->setPrev(prev);
+
+				hook->_next = hook->_prev = compact_hook::unlinked;
+				--_size;
+				return datumOf(hook);
+			}
+
+		public:
+
+			template <typename Ref>
+			class iterator_t {
+				friend class compact_hook_list;
+				const compact_hook_list* _list;
+				compact_hook* _hook;
+
+				iterator_t(const compact_hook_list* list, compact_hook* hook):
+					_list(list),
+					_hook(hook) { }
+
+			public:
+				using iterator_category = std::bidirectional_iterator_tag;
+				using value_type = T;
+				using difference_type = std::ptrdiff_t;
+				using pointer = Ref*;
+				using reference = Ref&;
+
+				reference operator * () const { return *datumOf(_hook); }
+
+				pointer operator -> () const { return datumOf(_hook); }
+
+				iterator_t& operator ++ () {
+					_hook = _hook->next();
+					return *this;
+				}
+
+				iterator_t operator ++ (int) {
+					iterator_t ret(*this);
+					++*this;
+					return ret;
+				}
+
+				iterator_t& operator -- () {
+					_hook = _hook == nullptr ? _list->_last : _hook->prev();
+					return *this;
+				}
+
+				iterator_t operator -- (int) {
+					iterator_t ret(*this);
+					--*this;
+					return ret;
+				}
+
+				bool operator == (const iterator_t& that) const { return _hook == that._hook; }
+
+				bool operator != (const iterator_t& that) const { return _hook != that._hook; }
+			};
+
+			using iterator = iterator_t<T>;
+			using const_iterator = iterator_t<const T>;
+
+			compact_hook_list() = default;
+
+			compact_hook_list(const compact_hook_list& that) = delete;
+
+			/**
+			 * O(1): hooks don't point to the list.
+			 */
+			compact_hook_list(compact_hook_list&& that) noexcept:
+				_first(that._first),
+				_last(that._last),
+				_size(that._size) {
+				that._first = that._last = nullptr;
+				that._size = 0;
+			}
+
+			~compact_hook_list() {
+				clear();
+			}
+
+			inline bool empty() const { return _first == nullptr; }
+
+			inline size_t size() const { return _size; }
+
+			/**
+			 * @return true if @param datum is linked (into some list).
+			 */
+			static inline bool linked(const T* datum) {
+				return (datum->*member).linked();
+			}
+
+			void push_back(T* datum) {
+				linkBefore(hookOf(datum), nullptr);
+			}
+
+			void push_front(T* datum) {
+				linkBefore(hookOf(datum), _first);
+			}
+
+			/**
+			 * Inserts @param datum before @param position.
+			 */
+			void insert(iterator position, T* datum) {
+				linkBefore(hookOf(datum), position._hook);
+			}
+
+			/**
+			 * @return the first entry, or nullptr if the list is empty.
+			 */
+			T* front() { return empty() ? nullptr : datumOf(_first); }
+
+			/**
+			 * @return the last entry, or nullptr if the list is empty.
+			 */
+			T* back() { return empty() ? nullptr : datumOf(_last); }
+
+			/**
+			 * Removes (and returns) the first entry.
+			 * @return nullptr if the list is empty.
+			 */
+			T* pop_front() { return unlinkAndGet(_first); }
+
+			/**
+			 * Removes (and returns) the last entry.
+			 * @return nullptr if the list is empty.
+			 */
+			T* pop_back() { return unlinkAndGet(_last); }
+
+			/**
+			 * Removes @param datum, which must be on this list.
+			 */
+			void erase(T* datum) {
+				unlinkAndGet(hookOf(datum));
+			}
+
+			/**
+			 * Removes the entry at @param position.
+			 * @return iterator to the next entry.
+			 */
+			iterator erase(iterator position) {
+				iterator ret(this, position._hook->next());
+				erase(&*position);
+				return ret;
+			}
+
+			/**
+			 * Removes all entries, NOT deleting them.
+			 */
+			void clear() {
+				while (pop_front());
+			}
+
+			iterator begin() { return iterator(this, _first); }
+
+			iterator end() { return iterator(this, nullptr); }
+
+			const_iterator begin() const { return const_iterator(this, _first); }
+
+			const_iterator end() const { return const_iterator(this, nullptr); }
+
+		};
+
+	}
+
+}
+
+#endif //O1CPPLIB_O1_D_LINKED_COMPACT_HOOK_LIST_HH
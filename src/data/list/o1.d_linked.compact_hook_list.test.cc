@@ -0,0 +1,179 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#include <gtest/gtest.h>
+#include <deque>
+#include <type_traits>
+#include <vector>
+#include "o1.d_linked.compact_hook_list.hh"
+#include "o1.d_linked.hook_list.hh"
+#include "../../memory/pool/o1.memory.pooled.hh"
+
+namespace {
+
+	struct Item {
+		int value;
+		o1::d_linked::compact_hook hook;
+
+		explicit Item(int _value): value(_value) { }
+	};
+
+	class PooledItem: public o1::memory::pooled<PooledItem, o1::memory::PoolStrategy::chunkedAlloc> {
+	public:
+		int value;
+		o1::d_linked::compact_hook hook;
+
+		explicit PooledItem(int _value): value(_value) { }
+	};
+
+	using list_t = o1::d_linked::compact_hook_list<Item, &Item::hook>;
+	using pooled_list_t = o1::d_linked::compact_hook_list<PooledItem, &PooledItem::hook>;
+
+	template <typename List>
+	std::vector<int> values(List& list) {
+		std::vector<int> ret;
+		for (auto& item: list)
+			ret.push_back(item.value);
+		return ret;
+	}
+
+	TEST(o1_d_linked_compact_hook_list, footprint) {
+		EXPECT_EQ(sizeof(o1::d_linked::compact_hook), 8);
+		EXPECT_EQ(2 * sizeof(o1::d_linked::compact_hook), sizeof(o1::d_linked::hook<>));
+		EXPECT_FALSE(std::is_polymorphic<o1::d_linked::compact_hook>::value);
+		EXPECT_EQ(sizeof(Item), 12);
+	}
+
+	TEST(o1_d_linked_compact_hook_list, push_and_pop) {
+		list_t list;
+		EXPECT_TRUE(list.empty());
+		EXPECT_EQ(list.pop_front(), nullptr);
+		EXPECT_EQ(list.pop_back(), nullptr);
+		EXPECT_EQ(list.front(), nullptr);
+
+		Item a{1}, b{2}, c{3};
+		EXPECT_FALSE(list_t::linked(&a));
+		list.push_back(&b);
+		list.push_back(&c);
+		list.push_front(&a);
+
+		EXPECT_EQ(list.size(), 3);
+		EXPECT_TRUE(list_t::linked(&b));
+		EXPECT_EQ(values(list), (std::vector<int>{1, 2, 3}));
+		EXPECT_EQ(list.front(), &a);
+		EXPECT_EQ(list.back(), &c);
+
+		list.erase(&b);
+		EXPECT_FALSE(list_t::linked(&b));
+		EXPECT_EQ(list.size(), 2);
+		EXPECT_EQ(values(list), (std::vector<int>{1, 3}));
+
+		EXPECT_EQ(list.pop_back(), &c);
+		EXPECT_TRUE(list_t::linked(&a));
+		EXPECT_EQ(list.pop_front(), &a);
+		EXPECT_TRUE(list.empty());
+		EXPECT_EQ(list.size(), 0);
+		EXPECT_FALSE(list_t::linked(&a));
+	}
+
+	TEST(o1_d_linked_compact_hook_list, iterators) {
+		std::deque<Item> items;
+		list_t list;
+		for (int i = 0; i < 5; ++i) {
+			items.emplace_back(i);
+			list.push_back(&items.back());
+		}
+
+		auto i = list.begin();
+		++i;
+		i = list.erase(i);
+		EXPECT_EQ(i->value, 2);
+		list.insert(i, &items[1]);
+		list.erase(&items[4]);
+		list.insert(list.end(), &items[4]);
+		EXPECT_EQ(values(list), (std::vector<int>{0, 1, 2, 3, 4}));
+
+		auto last = list.end();
+		--last;
+		EXPECT_EQ(last->value, 4);
+
+		const list_t& clist = list;
+		int sum = 0;
+		for (const auto& item: clist)
+			sum += item.value;
+		EXPECT_EQ(sum, 10);
+
+		for (auto j = list.begin(); j != list.end();)
+			j = j->value % 2 ? list.erase(j) : std::next(j);
+		EXPECT_EQ(values(list), (std::vector<int>{0, 2, 4}));
+	}
+
+	TEST(o1_d_linked_compact_hook_list, move) {
+		list_t list;
+		Item a{1}, b{2};
+		list.push_back(&a);
+		list.push_back(&b);
+
+		list_t moved(std::move(list));
+		EXPECT_TRUE(list.empty());
+		EXPECT_EQ(moved.size(), 2);
+		EXPECT_EQ(values(moved), (std::vector<int>{1, 2}));
+
+		moved.clear();
+		EXPECT_FALSE(list_t::linked(&a));
+		EXPECT_FALSE(list_t::linked(&b));
+	}
+
+	TEST(o1_d_linked_compact_hook_list, pooled) {
+		// spans several pool chunks.
+		const int count = 10000;
+		pooled_list_t list;
+		for (int i = 0; i < count; ++i)
+			list.push_back(new PooledItem(i));
+
+		EXPECT_EQ(list.size(), count);
+		long sum = 0;
+		for (auto& item: list)
+			sum += item.value;
+		EXPECT_EQ(sum, long(count) * (count - 1) / 2);
+
+		for (int i = 0; i < count; ++i) {
+			auto item = i % 2 ? list.pop_back() : list.pop_front();
+			ASSERT_NE(item, nullptr);
+			delete item;
+		}
+		EXPECT_TRUE(list.empty());
+	}
+
+}
@@ -0,0 +1,266 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#ifndef O1CPPLIB_O1_D_LINKED_HOOK_LIST_HH
+#define O1CPPLIB_O1_D_LINKED_HOOK_LIST_HH
+
+#include <cstddef>
+#include <iterator>
+#include "../node/o1.container_of.hh"
+#include "../node/o1.d_linked.hook.hh"
+
+namespace o1 {
+
+	namespace d_linked {
+
+		/**
+		 * Double (circular) linked list of T objects, linked through
+		 * their @tparam member hook.
+		 *
+		 * Compared to d_linked::list_t: hooks are two pointers (no
+		 * vtable, no per node pointer to the datum, which is found from
+		 * the hook address), linking and unlinking is just pointer
+		 * updates (no event handlers, nor reference counting), and the
+		 * list itself keeps its size.
+		 *
+		 * Upon destruction, remaining entries are unlinked (NOT deleted).
+		 *
+		 * @tparam Hook hook<false> or hook<true> (see hook).
+		 */
+		template <typename T, typename Hook, Hook T::*member>
+		class hook_list {
+
+			Hook _head;
+			size_t _size{0};
+
+			inline void init() {
+				_head._next = _head._prev = &_head;
+			}
+
+			static inline Hook* hookOf(T* datum) {
+				return &(datum->*member);
+			}
+
+			static inline T* datumOf(Hook* hook) {
+				return o1::container_of(hook, member);
+			}
+
+			T* unlinkAndGet(Hook* hook) {
+				if (hook == &_head)
+					return nullptr;
+				hook->_unlink();
+				--_size;
+				return datumOf(hook);
+			}
+
+		public:
+
+			template <typename Ref>
+			class iterator_t {
+				friend class hook_list;
+				Hook* _hook;
+
+				explicit iterator_t(Hook* hook): _hook(hook) { }
+
+			public:
+				using iterator_category = std::bidirectional_iterator_tag;
+				using value_type = T;
+				using difference_type = std::ptrdiff_t;
+				using pointer = Ref*;
+				using reference = Ref&;
+
+				reference operator * () const { return *datumOf(_hook); }
+
+				pointer operator -> () const { return datumOf(_hook); }
+
+				iterator_t& operator ++ () {
+					_hook = _hook->_next;
+					return *this;
+				}
+
+				iterator_t operator ++ (int) {
+					iterator_t ret(*this);
+					++*this;
+					return ret;
+				}
+
+				iterator_t& operator -- () {
+					_hook = _hook->_prev;
+					return *this;
+				}
+
+				iterator_t operator -- (int) {
+					iterator_t ret(*this);
+					--*this;
+					return ret;
+				}
+
+				bool operator == (const iterator_t& that) const { return _hook == that._hook; }
+
+				bool operator != (const iterator_t& that) const { return _hook != that._hook; }
+			};
+
+			using iterator = iterator_t<T>;
+			using const_iterator = iterator_t<const T>;
+
+			hook_list() { init(); }
+
+			hook_list(const hook_list& that) = delete;
+
+			/**
+			 * O(1): only the first and last entries get relinked.
+			 */
+			hook_list(hook_list&& that) noexcept:
+				_size(that._size) {
+				if (that.empty()) {
+					init();
+					return;
+				}
+
+				_head._next = that._head._next;
+				_head._prev = that._head._prev;
+				_head._next->_prev = &_head;
+				_head._prev->_next = &_head;
+
+				that.init();
+				that._size = 0;
+			}
+
+			~hook_list() {
+				clear();
+				_head._next = _head._prev = nullptr;
+			}
+
+			inline bool empty() const { return _head._next == &_head; }
+
+			/**
+			 * O(1), unless hooks unlink themselves (auto-unlink hooks).
+			 */
+			size_t size() const {
+				if (!Hook::autoUnlink)
+					return _size;
+
+				size_t ret = 0;
+				for (auto hook = _head._next; hook != &_head; hook = hook->_next)
+					++ret;
+				return ret;
+			}
+
+			/**
+			 * @return true if @param datum is linked (into some list).
+			 */
+			static inline bool linked(const T* datum) {
+				return (datum->*member).linked();
+			}
+
+			void push_back(T* datum) {
+				hookOf(datum)->linkBefore(&_head);
+				++_size;
+			}
+
+			void push_front(T* datum) {
+				hookOf(datum)->linkBefore(_head._next);
+				++_size;
+			}
+
+			/**
+			 * Inserts @param datum before @param position.
+			 */
+			void insert(iterator position, T* datum) {
+				hookOf(datum)->linkBefore(position._hook);
+				++_size;
+			}
+
+			/**
+			 * @return the first entry, or nullptr if the list is empty.
+			 */
+			T* front() { return empty() ? nullptr : datumOf(_head._next); }
+
+			/**
+			 * @return the last entry, or nullptr if the list is empty.
+			 */
+			T* back() { return empty() ? nullptr : datumOf(_head._prev); }
+
+			/**
+			 * Removes (and returns) the first entry.
+			 * @return nullptr if the list is empty.
+			 */
+			T* pop_front() { return unlinkAndGet(_head._next); }
+
+			/**
+			 * Removes (and returns) the last entry.
+			 * @return nullptr if the list is empty.
+			 */
+			T* pop_back() { return unlinkAndGet(_head._prev); }
+
+			/**
+			 * Removes @param datum, which must be on this list.
+			 */
+			void erase(T* datum) {
+				hookOf(datum)->_unlink();
+				--_size;
+			}
+
+			/**
+			 * Removes the entry at @param position.
+			 * @return iterator to the next entry.
+			 */
+			iterator erase(iterator position) {
+				iterator ret(position._hook->_next);
+				erase(&*position);
+				return ret;
+			}
+
+			/**
+			 * Removes all entries, NOT deleting them.
+			 */
+			void clear() {
+				while (pop_front());
+			}
+
+			iterator begin() { return iterator(_head._next); }
+
+			iterator end() { return iterator(&_head); }
+
+			const_iterator begin() const { return const_iterator(_head._next); }
+
+			const_iterator end() const { return const_iterator(const_cast<Hook*>(&_head)); }
+
+		};
+
+	}
+
+}
+
+#endif //O1CPPLIB_O1_D_LINKED_HOOK_LIST_HH
@@ -32,15 +32,29 @@
  */
 
 #include "o1.d_linked.list.hh"
+#include "../../o1.debug.hh"
+#include "../../o1.logging.hh"
 
 using o1::d_linked::list;
 using node = o1::d_linked::list::node;
 
 
-void o1::d_linked::list::_quick_move_to(list* list) {
-	_nodeEventHandlers->setList(list);
-	_nodeEventHandlers = std::make_shared<NodeEventHandlers>(this);
-	_node.reset(_nodeEventHandlers);
+void o1::d_linked::list::_quick_release() {
+	if (auto cell = _node.cell())
+		cell->setHandlers(nullptr);
+	_node.reset();
+	_numElements = 0;
+}
+
+void list::_relink(node* chain) {
+	node* prev = &_node;
+	for (node* n = chain; n != nullptr; n = n->_next) {
+		prev->_next = n;
+		n->_prev = prev;
+		prev = n;
+	}
+	prev->_next = &_node;
+	_node._prev = prev;
 }
 
 list::list(list::EventHandlers* handlers):
@@ -51,12 +65,26 @@ list::list(list&& that) noexcept:
 	_numElements(that._numElements),
 	_listEventHandlers(that._listEventHandlers),
 	_node(std::move(that._node)) {
+	if (auto cell = _node.cell())
+		cell->setHandlers(&_nodeEventHandlers);
 	that._numElements = 0;
-	that._quick_move_to(this);
+}
+
+list::~list() {
+	// Remaining nodes keep linked among themselves, but not to us.
+	_quick_release();
 }
 
 void list::flush() {
-	_quick_move_to(nullptr);
+	_quick_release();
+}
+
+void list::reserve() {
+	if (_node.cell() == nullptr) {
+		auto cell = node::membership::acquire(&_nodeEventHandlers);
+		_node.reset(cell);
+		cell->release();
+	}
 }
 
 node*
@@ -83,12 +111,105 @@ node* list::pop_back() {
 	return nullptr;
 }
 
-list::NodeEventHandlers::NodeEventHandlers(list* list):
-	_list(list) {
+void list::splice(list& other) {
+	if (&other == this || other.empty())
+		return;
+
+	node* first = other._node._next;
+	node* last = other._node._prev;
+	auto cell = other._node.cell();
+
+	if (empty()) {
+		// just like a move.
+		cell->setHandlers(&_nodeEventHandlers);
+		_node.setMembership(cell);
+	} else {
+		// other's nodes keep their cell, which now stands for this list.
+		cell->forwardTo(_node.cell());
+	}
+
+	other._node._next = other._node._prev = &other._node;
+	other._node.setMembership(nullptr);
+
+	first->_prev = _node._prev;
+	_node._prev->_next = first;
+	last->_next = &_node;
+	_node._prev = last;
+
+	_numElements += other._numElements;
+	other._numElements = 0;
+}
+
+void list::splice(node* position, list& other, node* first, node* last) {
+	if (first == last)
+		return;
+
+	if (&other != this && first == other.start() && last == other.finish() && position == finish()) {
+		splice(other);
+		return;
+	}
+
+	node* back = last->_prev;
+	size_t count = 0;
+
+	if (&other != this) {
+		reserve();
+		for (node* n = first; n != last; n = n->_next) {
+			n->setMembership(_node.cell());
+			++count;
+		}
+	}
+
+	first->_prev->_next = last;
+	last->_prev = first->_prev;
+
+	first->_prev = position->_prev;
+	position->_prev->_next = first;
+	back->_next = position;
+	position->_prev = back;
+
+	other._numElements -= count;
+	_numElements += count;
 }
 
-void list::NodeEventHandlers::setList(list* newList) {
-	_list = newList;
+void list::split_at(node* at, list& tail) {
+	o1::xassert(tail.empty(), "o1::d_linked::list::split_at: tail list is not empty");
+	tail.splice(tail.finish(), *this, at, finish());
+}
+
+void list::push_back_chain(node* first, node* last, size_t count) {
+	reserve();
+
+	node* n = first;
+	for (size_t i = 0; i < count; ++i, n = n->_next) {
+		if (o1::flags::extended_checks()) {
+			o1::xassert(
+				n != &_node && (n->cell() == nullptr || n->cell()->handlers() == nullptr),
+				"o1::d_linked::list::push_back_chain: node belongs to a list"
+			);
+		}
+		n->setMembership(_node.cell());
+	}
+
+	o1::xassert(n == last->_next, "o1::d_linked::list::push_back_chain: wrong count");
+
+	node* rest = last->_next;
+	if (rest != first) {
+		rest->_prev = first->_prev;
+		first->_prev->_next = rest;
+		rest->releaseIfOrphan();
+	}
+
+	first->_prev = _node._prev;
+	_node._prev->_next = first;
+	last->_next = &_node;
+	_node._prev = last;
+
+	_numElements += count;
+}
+
+list::NodeEventHandlers::NodeEventHandlers(list* list):
+	_list(list) {
 }
 
 void list::NodeEventHandlers::attaching(node* node) {
@@ -97,8 +218,10 @@ void list::NodeEventHandlers::attaching(node* node) {
 }
 
 void list::NodeEventHandlers::attached(node* node) {
+	if (_list == nullptr)
+		return;
 	_list->_numElements++;
-	if (_list && _list->_listEventHandlers)
+	if (_list->_listEventHandlers)
 		_list->_listEventHandlers->attached(node, _list);
 }
 
@@ -108,8 +231,10 @@ void list::NodeEventHandlers::detaching(node* node) {
 }
 
 void list::NodeEventHandlers::detached(node* node) {
+	if (_list == nullptr)
+		return;
 	_list->_numElements--;
-	if (_list && _list->_listEventHandlers)
+	if (_list->_listEventHandlers)
 		_list->_listEventHandlers->detached(node, _list);
 }
 
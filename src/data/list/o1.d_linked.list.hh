@@ -37,8 +37,8 @@
 #include <cstddef>
 #include <algorithm>
 #include <utility>
-#include <memory>
 #include "../node/o1.d_linked.node.hh"
+#include "./o1.merge_sort.hh"
 
 namespace o1 {
 
@@ -59,6 +59,10 @@ namespace o1 {
 		 * - pop_back (pop)
 		 * - pop_front (shift)
 		 * - Any random node detached.
+		 * - splice of a whole list.
+		 *
+		 * Nodes moved in bulk (splice(), split_at(), push_back_chain())
+		 * do NOT trigger node (nor list) events: only sizes get updated.
 		 *
 		 */
 		class list {
@@ -75,8 +79,6 @@ namespace o1 {
 			public:
 				explicit NodeEventHandlers(list* list);
 
-				void setList(list* newList);
-
 				void attaching(node* node) override;
 
 				void attached(node* node) override;
@@ -88,12 +90,27 @@ namespace o1 {
 
 			size_t _numElements{0};
 			EventHandlers* _listEventHandlers{nullptr};
-			std::shared_ptr<NodeEventHandlers> _nodeEventHandlers{
-				std::make_shared<NodeEventHandlers>(this)
-			};
-			node _node{_nodeEventHandlers};
+			NodeEventHandlers _nodeEventHandlers{this};
+
+			/**
+			 * Sentinel node; its membership cell is the one of the list,
+			 * acquired on the first insertion (see reserve()).
+			 */
+			node _node;
 
-			void _quick_move_to(list* list);
+			/**
+			 * Makes the nodes linked to the sentinel forget about this
+			 * list, and leaves the sentinel alone.
+			 */
+			void _quick_release();
+
+			/**
+			 * Links the null terminated @param chain (of nodes already
+			 * on this list) back into the ring, after the sentinel.
+			 */
+			void _relink(node* chain);
+
+			static inline node*& _nextOf(node* node) { return node->_next; }
 
 		public:
 			list() = default;
@@ -102,18 +119,30 @@ namespace o1 {
 
 			list(const list& that) = delete;
 
+			/**
+			 * O(1), w/out allocating memory.
+			 */
 			list(list&& that) noexcept;
 
 			/**
 			 * Remove all nodes from the list, NOT deleting them.
+			 * O(1), w/out allocating memory: removed nodes remain linked
+			 * among themselves.
 			 */
 			void flush();
 
+			/**
+			 * Sets up the list membership cell ahead of time, so that the
+			 * next insertion does not have to (it's kept until the list
+			 * gets moved, flushed or destroyed).
+			 */
+			void reserve();
+
 			/**
 			 * Upon destruction, entries are NOT deleted.
 			 * They'll form a  double linked list on their own.
 			 */
-			virtual ~list() = default;
+			virtual ~list();
 
 			/**
 			 * First node of the list.
@@ -171,6 +200,7 @@ namespace o1 {
 			 * @param node node inserted at the end of the list.
 			 */
 			inline void push_back(node* node) {
+				reserve();
 				_node.push_back(node);
 			}
 
@@ -179,6 +209,7 @@ namespace o1 {
 			 * @param node node inserted at the beginning of the list.
 			 */
 			inline void push_front(node* node) {
+				reserve();
 				_node.push_front(node);
 			}
 
@@ -194,6 +225,77 @@ namespace o1 {
 			 */
 			node* pop_front();
 
+			/**
+			 * Moves all the nodes of @param other to the end of this list.
+			 * O(1): the membership cell of @param other gets forwarded to
+			 * the one of this list.
+			 */
+			void splice(list& other);
+
+			/**
+			 * Moves the nodes [@param first, @param last) of @param other
+			 * before @param position (finish() to append them).
+			 * O(1) for a whole list, O(moved nodes) otherwise (each node
+			 * gets its membership updated); O(1) within the same list.
+			 */
+			void splice(node* position, list& other, node* first, node* last);
+
+			/**
+			 * Moves the nodes from @param at to the end of the list into
+			 * the (empty) @param tail list.
+			 * O(moved nodes), O(1) if @param at is the first node.
+			 */
+			void split_at(node* at, list& tail);
+
+			/**
+			 * Appends the chain of nodes @param first ... @param last
+			 * (both included) of @param count nodes, not belonging to a
+			 * list (e.g.: the nodes left linked after a flush()); the chain
+			 * gets unlinked from the rest of the nodes it's linked to.
+			 * O(count).
+			 */
+			void push_back_chain(node* first, node* last, size_t count);
+
+			/**
+			 * Stable sort, w/out allocating memory (nodes get relinked,
+			 * w/out any event).
+			 * O(n log n).
+			 * @param less(a, b) tells if node a goes before node b.
+			 */
+			template <typename Less>
+			void sort(Less less) {
+				if (_node._next == _node._prev)
+					return;
+
+				_node._prev->_next = nullptr;
+				_relink(o1::merge_sort::sort(_node._next, _nextOf, less));
+			}
+
+			/**
+			 * Moves the nodes of @param other into this list, both being
+			 * sorted (by @param less); on ties, nodes of this list go
+			 * first.  Just like splice(other), no events are triggered.
+			 * O(n + m).
+			 */
+			template <typename Less>
+			void merge(list& other, Less less) {
+				if (&other == this || other.empty())
+					return;
+
+				if (empty()) {
+					splice(other);
+					return;
+				}
+
+				node* mid = other._node._next;
+				splice(other);
+
+				mid->_prev->_next = nullptr;
+				_node._prev->_next = nullptr;
+				auto next = _nextOf;
+				_relink(o1::merge_sort::merge(_node._next, mid, next, less));
+			}
+
 		};
 
 	}
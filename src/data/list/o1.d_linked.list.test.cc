@@ -32,7 +32,10 @@
  */
 
 #include <gtest/gtest.h>
+#include <memory>
+#include <thread>
 #include "o1.d_linked.list.hh"
+#include "../../memory/o1.memory.allocations.test.hh"
 
 namespace {
 
@@ -279,4 +282,231 @@ namespace {
 		EXPECT_EQ(list.size(), 0);
 	}
 
+	TEST(o1_d_linked, Flush) {
+		o1::d_linked::list list;
+		auto a = new o1::d_linked::node();
+		o1::d_linked::node b;
+		list.push_back(a);
+		list.push_back(&b);
+
+		list.flush();
+		EXPECT_TRUE(list.empty());
+		EXPECT_EQ(list.size(), 0);
+
+		// flushed nodes remain linked among themselves, not to the list.
+		EXPECT_EQ(a->next(), &b);
+		delete a;
+		EXPECT_TRUE(b.empty());
+
+		list.push_back(&b);
+		EXPECT_EQ(list.size(), 1);
+	}
+
+	TEST(o1_d_linked, NodesOutliveList) {
+		o1::d_linked::node a, b;
+		{
+			o1::d_linked::list list;
+			list.push_back(&a);
+			list.push_back(&b);
+		}
+		a.detach();
+		EXPECT_TRUE(a.empty());
+		EXPECT_TRUE(b.empty());
+	}
+
+	TEST(o1_d_linked, NoAllocations) {
+		o1::d_linked::node a, b;
+		{
+			// warm up the membership cells.
+			o1::d_linked::list list;
+			list.push_back(&a);
+		}
+
+		size_t before = o1::memory::test::allocations();
+
+		o1::d_linked::list list;
+		o1::d_linked::list moved(std::move(list));
+		moved.flush();
+		o1::d_linked::list empty;
+		moved.push_back(&b);
+		o1::d_linked::list target(std::move(moved));
+		target.flush();
+		size_t sizes = list.size() + moved.size() + target.size() + empty.size();
+
+		size_t after = o1::memory::test::allocations();
+
+		EXPECT_EQ(after, before);
+		EXPECT_EQ(sizes, 0);
+	}
+
+	TEST(o1_d_linked, SpliceWholeList) {
+		o1::d_linked::list dst, src;
+		o1::d_linked::node nodes[6];
+		for (size_t i = 0; i < 3; ++i) {
+			dst.push_back(&nodes[i]);
+			src.push_back(&nodes[3 + i]);
+		}
+
+		dst.splice(src);
+		EXPECT_TRUE(src.empty());
+		EXPECT_EQ(src.size(), 0);
+		EXPECT_EQ(dst.size(), 6);
+
+		size_t i = 0;
+		for (auto n = dst.start(); n != dst.finish(); n = n->next())
+			EXPECT_EQ(n, &nodes[i++]);
+		EXPECT_EQ(i, 6);
+
+		// spliced nodes now belong to dst.
+		nodes[4].detach();
+		EXPECT_EQ(dst.size(), 5);
+		EXPECT_EQ(dst.pop_back(), &nodes[5]);
+		EXPECT_EQ(dst.size(), 4);
+
+		// and src is usable again.
+		src.push_back(&nodes[5]);
+		EXPECT_EQ(src.size(), 1);
+		EXPECT_EQ(dst.size(), 4);
+	}
+
+	TEST(o1_d_linked, SpliceChained) {
+		o1::d_linked::list a, b, c;
+		o1::d_linked::node x, y, z;
+		a.push_back(&x);
+		b.push_back(&y);
+		c.push_back(&z);
+
+		b.splice(a);
+		c.splice(b);
+		EXPECT_EQ(c.size(), 3);
+
+		x.detach();
+		EXPECT_EQ(c.size(), 2);
+
+		o1::d_linked::list d(std::move(c));
+		y.detach();
+		EXPECT_EQ(d.size(), 1);
+
+		d.flush();
+		EXPECT_EQ(d.size(), 0);
+		z.detach();
+		EXPECT_EQ(d.size(), 0);
+	}
+
+	TEST(o1_d_linked, SpliceRange) {
+		o1::d_linked::list dst, src;
+		o1::d_linked::node a, b, c, d, e;
+		dst.push_back(&a);
+		dst.push_back(&e);
+		src.push_back(&b);
+		src.push_back(&c);
+		src.push_back(&d);
+
+		dst.splice(&e, src, &b, src.finish());
+		EXPECT_TRUE(src.empty());
+		EXPECT_EQ(dst.size(), 5);
+
+		o1::d_linked::node* expected[] = { &a, &b, &c, &d, &e };
+		size_t i = 0;
+		for (auto n = dst.start(); n != dst.finish(); n = n->next())
+			EXPECT_EQ(n, expected[i++]);
+
+		// within the same list.
+		dst.splice(dst.finish(), dst, &a, &b);
+		EXPECT_EQ(dst.size(), 5);
+		EXPECT_EQ(dst.r_start(), &a);
+		EXPECT_EQ(dst.start(), &b);
+
+		c.detach();
+		EXPECT_EQ(dst.size(), 4);
+	}
+
+	TEST(o1_d_linked, SplitAt) {
+		o1::d_linked::list list, tail;
+		o1::d_linked::node nodes[5];
+		for (auto& node: nodes)
+			list.push_back(&node);
+
+		list.split_at(&nodes[2], tail);
+		EXPECT_EQ(list.size(), 2);
+		EXPECT_EQ(tail.size(), 3);
+		EXPECT_EQ(list.r_start(), &nodes[1]);
+		EXPECT_EQ(tail.start(), &nodes[2]);
+		EXPECT_EQ(tail.r_start(), &nodes[4]);
+
+		nodes[3].detach();
+		EXPECT_EQ(list.size(), 2);
+		EXPECT_EQ(tail.size(), 2);
+
+		o1::d_linked::list rest;
+		tail.split_at(tail.start(), rest);
+		EXPECT_TRUE(tail.empty());
+		EXPECT_EQ(rest.size(), 2);
+	}
+
+	TEST(o1_d_linked, PushBackChain) {
+		o1::d_linked::node a, b, c;
+		{
+			o1::d_linked::list list;
+			list.push_back(&a);
+			list.push_back(&b);
+			list.push_back(&c);
+			list.flush();
+		}
+
+		// a and c get moved, b is left alone.
+		o1::d_linked::list list;
+		list.push_back_chain(&c, &a, 2);
+		EXPECT_EQ(list.size(), 2);
+		EXPECT_EQ(list.start(), &c);
+		EXPECT_EQ(list.r_start(), &a);
+		EXPECT_TRUE(b.empty());
+		EXPECT_EQ(b.cell(), nullptr);
+
+		a.detach();
+		EXPECT_EQ(list.size(), 1);
+	}
+
+	TEST(o1_d_linked, SpliceNoAllocations) {
+		o1::d_linked::node nodes[4];
+		o1::d_linked::list dst, src, tail;
+		// a partial split needs a membership cell for the tail list.
+		tail.reserve();
+		dst.push_back(&nodes[0]);
+		src.push_back(&nodes[1]);
+		src.push_back(&nodes[2]);
+		src.push_back(&nodes[3]);
+
+		size_t before = o1::memory::test::allocations();
+
+		dst.splice(src);
+		dst.split_at(&nodes[2], tail);
+		src.splice(tail);
+
+		size_t after = o1::memory::test::allocations();
+
+		EXPECT_EQ(after, before);
+		EXPECT_EQ(dst.size(), 2);
+		EXPECT_EQ(src.size(), 2);
+	}
+
+
+	/**
+	 * Constructed before the thread's cell pool, so destroyed after it.
+	 */
+	struct late_list {
+		std::unique_ptr<o1::d_linked::list> list;
+		o1::d_linked::node node;
+	};
+
+	TEST(o1_d_linked, ReleaseAfterPoolDestruction) {
+		std::thread thread([]() {
+			static thread_local late_list late;
+			late.list.reset(new o1::d_linked::list());
+			late.list->push_back(&late.node);
+		});
+		thread.join();
+		SUCCEED();
+	}
+
 }
@@ -34,6 +34,7 @@
 #ifndef O1CPPLIB_O1_D_LINKED_LIST_T_HH
 #define O1CPPLIB_O1_D_LINKED_LIST_T_HH
 
+#include <functional>
 #include "./o1.d_linked.list.hh"
 #include "../node/o1.d_linked.node_t.hh"
 #include "../iterator/o1.forward_iterator_ref.hh"
@@ -56,10 +57,26 @@ namespace o1 {
 				node_t,
 				list_t
 			>;
+			using iterator = o1::forward_iterator_ref<node_t, T>;
+			using const_iterator = o1::forward_iterator_ref<const node_t, const T>;
+			using reverse_iterator = o1::backward_iterator_ref<node_t, T>;
+			using const_reverse_iterator = o1::backward_iterator_ref<const node_t, const T>;
 
 		private:
 			getNodeFn getNode{nullptr};
 
+			/**
+			 * All nodes but the sentinel (finish()) are node_t, so this
+			 * is a static (fixed offset) conversion.
+			 */
+			inline node_t* typed(o1::d_linked::node* node) {
+				return node == finish() ? nullptr : static_cast<node_t*>(node);
+			}
+
+			inline const node_t* typed(const o1::d_linked::node* node) const {
+				return node == finish() ? nullptr : static_cast<const node_t*>(node);
+			}
+
 		public:
 
 			list_t() = delete;
@@ -91,36 +108,78 @@ namespace o1 {
 					delete element;
 			}
 
+			/**
+			 * @return the first node, or nullptr if the list is empty.
+			 */
 			node_t* start() {
-				return dynamic_cast<node_t*>(this->d_linked::list::start());
+				return typed(this->d_linked::list::start());
 			}
 
 			const node_t* start() const {
-				return dynamic_cast<const node_t*>(this->d_linked::list::start());
+				return typed(this->d_linked::list::start());
 			}
 
+			/**
+			 * @return the last node, or nullptr if the list is empty.
+			 */
 			node_t* r_start() {
-				return dynamic_cast<node_t*>(this->d_linked::list::r_start());
+				return typed(this->d_linked::list::r_start());
 			}
 
 			const node_t* r_start() const {
-				return dynamic_cast<const node_t*>(this->d_linked::list::r_start());
+				return typed(this->d_linked::list::r_start());
 			}
 
-			o1::forward_iterator_ref<node_t, T> begin() {
-				return o1::forward_iterator_ref<node_t, T>(start());
+			iterator begin() {
+				return iterator(start(), finish());
 			}
 
-			o1::forward_iterator_ref<node_t, T> end() {
-				return o1::forward_iterator_ref<node_t, T>(nullptr);
+			iterator end() {
+				return iterator(nullptr, finish());
 			}
 
-			o1::backward_iterator_ref<node_t, T> rbegin() {
-				return o1::backward_iterator_ref<node_t, T>(r_start());
+			const_iterator begin() const {
+				return const_iterator(start(), finish());
 			}
 
-			o1::backward_iterator_ref<node_t, T> rend() {
-				return o1::backward_iterator_ref<node_t, T>(nullptr);
+			const_iterator end() const {
+				return const_iterator(nullptr, finish());
+			}
+
+			const_iterator cbegin() const { return begin(); }
+
+			const_iterator cend() const { return end(); }
+
+			reverse_iterator rbegin() {
+				return reverse_iterator(r_start(), finish());
+			}
+
+			reverse_iterator rend() {
+				return reverse_iterator(nullptr, finish());
+			}
+
+			const_reverse_iterator rbegin() const {
+				return const_reverse_iterator(r_start(), finish());
+			}
+
+			const_reverse_iterator rend() const {
+				return const_reverse_iterator(nullptr, finish());
+			}
+
+			/**
+			 * Removes (NOT deleting) the element at @param position, for
+			 * erasing while iterating:
+			 *
+			 *     for (auto i = list.begin(); i != list.end();)
+			 *         i = drop(*i) ? list.erase(i) : std::next(i);
+			 *
+			 * @return iterator to the next element.
+			 */
+			iterator erase(iterator position) {
+				node_t* node = position.node();
+				++position;
+				node->detach();
+				return position;
 			}
 
 			using d_linked::list::empty;
@@ -166,6 +225,47 @@ namespace o1 {
 				);
 			}
 
+			using d_linked::list::splice;
+			using d_linked::list::split_at;
+			using d_linked::list::push_back_chain;
+
+			/**
+			 * "Alias" of d_linked::split_at(node, tail).
+			 * Moves the elements from @param datum on into @param tail.
+			 */
+			void split_at(T* datum, list_t& tail) {
+				d_linked::list::split_at(getNode(datum), tail);
+			}
+
+			/**
+			 * "Alias" of d_linked::push_back_chain(first, last, count).
+			 */
+			void push_back_chain(T* first, T* last, size_t count) {
+				d_linked::list::push_back_chain(getNode(first), getNode(last), count);
+			}
+
+			/**
+			 * Stable sort of the elements, by @param less; see
+			 * d_linked::list::sort().
+			 */
+			template <typename Less = std::less<T>>
+			void sort(Less less = Less()) {
+				d_linked::list::sort([&less](const node* a, const node* b) {
+					return less(*static_cast<const node_t*>(a)->ref(), *static_cast<const node_t*>(b)->ref());
+				});
+			}
+
+			/**
+			 * Merges the elements of @param other, both lists sorted by
+			 * @param less; see d_linked::list::merge().
+			 */
+			template <typename Less = std::less<T>>
+			void merge(list_t& other, Less less = Less()) {
+				d_linked::list::merge(other, [&less](const node* a, const node* b) {
+					return less(*static_cast<const node_t*>(a)->ref(), *static_cast<const node_t*>(b)->ref());
+				});
+			}
+
 		};
 
 	}
@@ -32,7 +32,11 @@
  */
 
 #include <gtest/gtest.h>
+#include <vector>
+#include <iterator>
+#include <algorithm>
 #include "o1.d_linked.list_t.hh"
+#include "../../memory/o1.memory.allocations.test.hh"
 
 namespace {
 
@@ -155,14 +159,36 @@ namespace {
 		}
 
 		inode = 0;
-		for (auto i: list) {
-			EXPECT_EQ(i->value, nodes[inode].value);
+		for (auto& i: list) {
+			EXPECT_EQ(i.value, nodes[inode].value);
 			EXPECT_LT(inode, 10) << "inode=" << inode;
 			++inode;
 		}
 
 	}
 
+	TEST(o1_d_linked_t, BackwardLoop) {
+		list_t list(getNode);
+		EXPECT_EQ(list.start(), nullptr);
+		EXPECT_EQ(list.r_start(), nullptr);
+		EXPECT_TRUE(list.rbegin() == list.rend());
+
+		MyNode nodes[10];
+		for (int i = 0; i < 10; ++i) {
+			nodes[i].value = i;
+			list.push_back(&nodes[i]);
+		}
+		EXPECT_EQ(list.start()->ref(), &nodes[0]);
+		EXPECT_EQ(list.r_start()->ref(), &nodes[9]);
+
+		int inode = 10;
+		for (auto i = list.rbegin(); i != list.rend(); ++i) {
+			--inode;
+			EXPECT_EQ(&*i, &nodes[inode]);
+		}
+		EXPECT_EQ(inode, 0);
+	}
+
 	TEST(o1_d_linked_t, SizeConsistency) {
 		list_t list(getNode);
 		EXPECT_EQ(list.size(), 0);
@@ -178,4 +204,161 @@ namespace {
 		EXPECT_EQ(list.size(), 0);
 	}
 
+	TEST(o1_d_linked_t, Sort) {
+		list_t list(getNode);
+		list.sort([](const MyNode& a, const MyNode& b) { return a.value < b.value; });
+		EXPECT_TRUE(list.empty());
+
+		MyNode nodes[100];
+		for (int i = 0; i < 100; ++i) {
+			nodes[i].value = (i * 37) % 100;
+			list.push_back(&nodes[i]);
+		}
+
+		list.sort([](const MyNode& a, const MyNode& b) { return a.value < b.value; });
+		EXPECT_EQ(list.size(), 100);
+		int expected = 0;
+		for (auto i = list.begin(); i != list.end(); ++i)
+			EXPECT_EQ(i->value, expected++);
+		EXPECT_EQ(expected, 100);
+
+		expected = 100;
+		for (auto i = list.rbegin(); i != list.rend(); ++i)
+			EXPECT_EQ(i->value, --expected);
+
+		// sorted nodes still belong to the list.
+		nodes[0].node.detach();
+		EXPECT_EQ(list.size(), 99);
+	}
+
+	TEST(o1_d_linked_t, SortIsStable) {
+		list_t list(getNode);
+		MyNode nodes[40];
+		for (int i = 0; i < 40; ++i) {
+			nodes[i].value = i;
+			list.push_back(&nodes[i]);
+		}
+
+		list.sort([](const MyNode& a, const MyNode& b) { return a.value % 4 < b.value % 4; });
+
+		int last = -1;
+		for (auto i = list.begin(); i != list.end(); ++i) {
+			int value = i->value;
+			if (last >= 0 && last % 4 == value % 4) {
+				EXPECT_LT(last, value);
+			}
+			if (last >= 0) {
+				EXPECT_LE(last % 4, value % 4);
+			}
+			last = value;
+		}
+	}
+
+	TEST(o1_d_linked_t, Merge) {
+		list_t left(getNode), right(getNode);
+		MyNode nodes[10];
+		for (int i = 0; i < 10; ++i) {
+			nodes[i].value = i / 2;
+			// ties: evens on the left, odds on the right.
+			(i % 2 == 0 ? left : right).push_back(&nodes[i]);
+		}
+
+		left.merge(right, [](const MyNode& a, const MyNode& b) { return a.value < b.value; });
+		EXPECT_TRUE(right.empty());
+		EXPECT_EQ(left.size(), 10);
+
+		int inode = 0;
+		for (auto i = left.begin(); i != left.end(); ++i)
+			EXPECT_EQ(&*i, &nodes[inode++]);
+		EXPECT_EQ(inode, 10);
+		EXPECT_EQ(left.r_start()->ref(), &nodes[9]);
+
+		nodes[9].node.detach();
+		EXPECT_EQ(left.size(), 9);
+	}
+
+	TEST(o1_d_linked_t, SortNoAllocations) {
+		MyNode nodes[100];
+		list_t list(getNode), other(getNode);
+		for (int i = 0; i < 100; ++i) {
+			nodes[i].value = (i * 37) % 100;
+			(i < 50 ? list : other).push_back(&nodes[i]);
+		}
+
+		size_t before = o1::memory::test::allocations();
+
+		list.sort([](const MyNode& a, const MyNode& b) { return a.value < b.value; });
+		other.sort([](const MyNode& a, const MyNode& b) { return a.value < b.value; });
+		list.merge(other, [](const MyNode& a, const MyNode& b) { return a.value < b.value; });
+
+		size_t after = o1::memory::test::allocations();
+
+		EXPECT_EQ(after, before);
+		EXPECT_EQ(list.size(), 100);
+	}
+
+	static_assert(
+		std::is_same<std::iterator_traits<list_t::iterator>::iterator_category, std::bidirectional_iterator_tag>::value,
+		"d_linked::list_t iterators are bidirectional"
+	);
+
+	TEST(o1_d_linked_t, StdAlgorithms) {
+		list_t list(getNode);
+		MyNode nodes[10];
+		for (int i = 0; i < 10; ++i) {
+			nodes[i].value = i;
+			list.push_back(&nodes[i]);
+		}
+
+		auto found = std::find_if(list.begin(), list.end(), [](const MyNode& node) { return node.value == 4; });
+		EXPECT_EQ(found.get(), &nodes[4]);
+		EXPECT_EQ(found->value, 4);
+		EXPECT_EQ(std::distance(list.begin(), list.end()), 10);
+
+		int sum = 0;
+		std::for_each(list.begin(), list.end(), [&sum](MyNode& node) { sum += node.value; });
+		EXPECT_EQ(sum, 45);
+
+		// const iteration.
+		const list_t& clist = list;
+		EXPECT_EQ(std::count_if(clist.begin(), clist.end(), [](const MyNode& node) { return node.value % 2 == 0; }), 5);
+		list_t::const_iterator ci = list.begin();
+		EXPECT_EQ(&*ci, &nodes[0]);
+		EXPECT_TRUE(ci == clist.cbegin());
+
+		// postfix and backwards, from end().
+		auto i = list.begin();
+		EXPECT_EQ(&*i++, &nodes[0]);
+		EXPECT_EQ(&*i, &nodes[1]);
+		auto last = list.end();
+		--last;
+		EXPECT_EQ(&*last, &nodes[9]);
+		EXPECT_EQ(&*last--, &nodes[9]);
+		EXPECT_EQ(&*last, &nodes[8]);
+
+		std::vector<int> reversed;
+		for (auto r = clist.rbegin(); r != clist.rend(); ++r)
+			reversed.push_back(r->value);
+		EXPECT_EQ(reversed, std::vector<int>({9, 8, 7, 6, 5, 4, 3, 2, 1, 0}));
+	}
+
+	TEST(o1_d_linked_t, EraseWhileIterating) {
+		list_t list(getNode);
+		MyNode nodes[10];
+		for (int i = 0; i < 10; ++i) {
+			nodes[i].value = i;
+			list.push_back(&nodes[i]);
+		}
+
+		for (auto i = list.begin(); i != list.end();)
+			i = i->value % 3 == 0 ? list.erase(i) : std::next(i);
+
+		EXPECT_EQ(list.size(), 6);
+		std::vector<int> left;
+		for (auto& node: list)
+			left.push_back(node.value);
+		EXPECT_EQ(left, std::vector<int>({1, 2, 4, 5, 7, 8}));
+		EXPECT_TRUE(nodes[9].node.empty());
+	}
+
 }
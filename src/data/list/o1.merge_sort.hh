@@ -0,0 +1,128 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#ifndef O1CPPLIB_O1_MERGE_SORT_HH
+#define O1CPPLIB_O1_MERGE_SORT_HH
+
+#include <cstddef>
+
+namespace o1 {
+
+	/**
+	 * Stable merge sort of null terminated node chains, w/out
+	 * allocating memory (nodes get relinked).
+	 *
+	 * @param next(node) returns a reference to the link to the next node.
+	 * @param less(a, b) tells if node a goes before node b.
+	 */
+	namespace merge_sort {
+
+		/**
+		 * Sorted runs kept while sorting: up to 2^bins - 1 nodes.
+		 */
+		static const constexpr size_t bins = 64;
+
+		/**
+		 * Merges the sorted chains @param a and @param b; on ties, nodes
+		 * of @param a go first.
+		 * @return the merged chain.
+		 */
+		template <typename Node, typename Next, typename Less>
+		Node* merge(Node* a, Node* b, Next& next, Less& less) {
+			Node* first = nullptr;
+			Node* last = nullptr;
+
+			while (a != nullptr && b != nullptr) {
+				Node* taken;
+				if (less(b, a)) {
+					taken = b;
+					b = next(b);
+				} else {
+					taken = a;
+					a = next(a);
+				}
+
+				if (last == nullptr)
+					first = taken;
+				else
+					next(last) = taken;
+				last = taken;
+			}
+
+			Node* rest = a != nullptr ? a : b;
+			if (last == nullptr)
+				return rest;
+			next(last) = rest;
+			return first;
+		}
+
+		/**
+		 * Bottom up: runs of 1, 2, 4, ... nodes get merged as nodes are
+		 * taken from @param chain, older runs first (hence stable).
+		 * @return the sorted chain.
+		 */
+		template <typename Node, typename Next, typename Less>
+		Node* sort(Node* chain, Next next, Less less) {
+			Node* runs[bins] = {};
+			size_t used = 0;
+
+			while (chain != nullptr) {
+				Node* carry = chain;
+				chain = next(chain);
+				next(carry) = nullptr;
+
+				size_t i = 0;
+				for (; i < used && runs[i] != nullptr; ++i) {
+					carry = merge(runs[i], carry, next, less);
+					runs[i] = nullptr;
+				}
+
+				runs[i] = carry;
+				if (i == used)
+					++used;
+			}
+
+			Node* ret = nullptr;
+			for (size_t i = 0; i < used; ++i) {
+				if (runs[i] != nullptr)
+					ret = merge(runs[i], ret, next, less);
+			}
+			return ret;
+		}
+
+	}
+
+}
+
+#endif //O1CPPLIB_O1_MERGE_SORT_HH
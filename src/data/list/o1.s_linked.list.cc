@@ -38,11 +38,13 @@
 using o1::s_linked::list;
 using node = o1::s_linked::list::node;
 
-list::list(list&& that) noexcept {
+list::list(list&& that) noexcept:
+	_tail(that._tail == &that._head ? &_head : that._tail),
+	_size(that._size) {
 	_head.move(that._head);
 
 	that._tail = &that._head;
-	_tail = &_head;
+	that._size = 0;
 }
 
 void
@@ -71,6 +73,8 @@ list::push_front(node* node) {
 	s_linked::node* tmp = _head.next();
 	_head.next(node);
 	node->next(tmp);
+	if (_tail == &_head)
+		_tail = node;
 	++_size;
 }
 
@@ -89,3 +93,35 @@ list::pop_front() {
 	_tail = &_head;
 	return nullptr;
 }
+
+void list::splice(list& other) {
+	if (&other == this || other.empty())
+		return;
+
+	push_back_chain(other._head.next(nullptr), other._tail, other._size);
+	other._tail = &other._head;
+	other._size = 0;
+}
+
+void list::split_after(node* at, list& tail) {
+	o1::xassert(tail.empty(), "o1::s_linked::list::split_after: tail list is not empty");
+
+	node* first = at->next(nullptr);
+	if (first == nullptr)
+		return;
+
+	size_t count = 1;
+	for (node* n = first; n != _tail; n = n->next())
+		++count;
+
+	tail.push_back_chain(first, _tail, count);
+	_tail = at;
+	_size -= count;
+}
+
+void list::push_back_chain(node* first, node* last, size_t count) {
+	last->next(nullptr);
+	_tail->next(first);
+	_tail = last;
+	_size += count;
+}
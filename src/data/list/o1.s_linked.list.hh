@@ -37,6 +37,7 @@
 #include <cstddef>
 #include <algorithm>
 #include "../node/o1.s_linked.node.hh"
+#include "./o1.merge_sort.hh"
 
 namespace o1 {
 
@@ -53,6 +54,7 @@ namespace o1 {
 		 * - push_back (push, append)
 		 * - push_front (insert)
 		 * - pop_front (shift)
+		 * - splice, push_back_chain (bulk transfers)
 		 *
 		 * This data structure does not allow a random node to be detached.
 		 *
@@ -68,6 +70,8 @@ namespace o1 {
 			node* _tail;
 			size_t _size{0};
 
+			static inline node*& _nextOf(node* node) { return node->_next; }
+
 		public:
 			list() : _tail(&_head) {};
 
@@ -132,6 +136,72 @@ namespace o1 {
 			 */
 			node* pop_front();
 
+			/**
+			 * Moves all the nodes of @param other to the end of this list.
+			 * O(1).
+			 */
+			void splice(list& other);
+
+			/**
+			 * Moves the nodes following @param at into the (empty)
+			 * @param tail list.
+			 * O(moved nodes), as they get counted: there's no O(1) way
+			 * to split *at* a node, its predecessor is unknown.
+			 */
+			void split_after(node* at, list& tail);
+
+			/**
+			 * Appends the chain of nodes @param first ... @param last
+			 * (both included), of @param count nodes.
+			 * O(1).
+			 */
+			void push_back_chain(node* first, node* last, size_t count);
+
+			/**
+			 * Stable sort, w/out allocating memory (nodes get relinked).
+			 * O(n log n).
+			 * @param less(a, b) tells if node a goes before node b.
+			 */
+			template <typename Less>
+			void sort(Less less) {
+				if (_size < 2)
+					return;
+
+				node* n = o1::merge_sort::sort(_head._next, _nextOf, less);
+				_head._next = n;
+				while (n->_next != nullptr)
+					n = n->_next;
+				_tail = n;
+			}
+
+			/**
+			 * Moves the nodes of @param other into this list, both being
+			 * sorted (by @param less); on ties, nodes of this list go
+			 * first.
+			 * O(n + m).
+			 */
+			template <typename Less>
+			void merge(list& other, Less less) {
+				if (&other == this || other.empty())
+					return;
+
+				if (empty()) {
+					splice(other);
+					return;
+				}
+
+				// the greatest node is the last one, ours on ties.
+				node* tail = less(other._tail, _tail) ? _tail : other._tail;
+				auto next = _nextOf;
+				_head._next = o1::merge_sort::merge(_head._next, other._head._next, next, less);
+				_tail = tail;
+				_size += other._size;
+
+				other._head._next = nullptr;
+				other._tail = &other._head;
+				other._size = 0;
+			}
+
 		};
 
 	}
@@ -32,7 +32,10 @@
  */
 
 #include <gtest/gtest.h>
+#include <iterator>
+#include <algorithm>
 #include "o1.s_linked.list.hh"
+#include "o1.s_linked.list_t.hh"
 
 namespace {
 
@@ -104,4 +107,187 @@ namespace {
 
 	}
 
+	TEST(o1_s_linked, MoveConstructorKeepsTail) {
+		o1::s_linked::list src;
+		o1::s_linked::node a, b;
+		src.push_back(&a);
+		o1::s_linked::list dst(std::move(src));
+		dst.push_back(&b);
+		EXPECT_EQ(dst.size(), 2);
+		EXPECT_EQ(dst.start(), &a);
+		EXPECT_EQ(a.next(), &b);
+		EXPECT_EQ(src.size(), 0); // NOLINT(bugprone-use-after-move)
+	}
+
+	TEST(o1_s_linked, PushFrontThenBack) {
+		o1::s_linked::list list;
+		o1::s_linked::node a, b;
+		list.push_front(&a);
+		list.push_back(&b);
+		EXPECT_EQ(list.start(), &a);
+		EXPECT_EQ(a.next(), &b);
+	}
+
+	TEST(o1_s_linked, Splice) {
+		o1::s_linked::list dst, src;
+		o1::s_linked::node nodes[5];
+		dst.push_back(&nodes[0]);
+		dst.push_back(&nodes[1]);
+		src.push_back(&nodes[2]);
+		src.push_back(&nodes[3]);
+
+		dst.splice(src);
+		EXPECT_TRUE(src.empty());
+		EXPECT_EQ(src.size(), 0);
+		EXPECT_EQ(dst.size(), 4);
+
+		dst.push_back(&nodes[4]);
+		size_t i = 0;
+		for (auto node = dst.start(); node != nullptr; node = node->next())
+			EXPECT_EQ(node, &nodes[i++]);
+		EXPECT_EQ(i, 5);
+
+		src.push_back(dst.pop_front());
+		EXPECT_EQ(src.size(), 1);
+		EXPECT_EQ(dst.size(), 4);
+	}
+
+	TEST(o1_s_linked, SplitAfter) {
+		o1::s_linked::list list, tail;
+		o1::s_linked::node nodes[5];
+		for (auto& node: nodes)
+			list.push_back(&node);
+
+		list.split_after(&nodes[1], tail);
+		EXPECT_EQ(list.size(), 2);
+		EXPECT_EQ(tail.size(), 3);
+		EXPECT_EQ(nodes[1].next(), nullptr);
+		EXPECT_EQ(tail.start(), &nodes[2]);
+
+		// the tail is kept right on both lists.
+		o1::s_linked::node x, y;
+		list.push_back(&x);
+		tail.push_back(&y);
+		EXPECT_EQ(nodes[1].next(), &x);
+		EXPECT_EQ(nodes[4].next(), &y);
+	}
+
+	TEST(o1_s_linked, PushBackChain) {
+		o1::s_linked::node a, b, c;
+		a.next(&b);
+		b.next(&c);
+
+		o1::s_linked::list list;
+		list.push_back_chain(&a, &c, 3);
+		EXPECT_EQ(list.size(), 3);
+		EXPECT_EQ(list.pop_front(), &a);
+		EXPECT_EQ(list.pop_front(), &b);
+		EXPECT_EQ(list.pop_front(), &c);
+		EXPECT_TRUE(list.empty());
+	}
+
+	struct Item {
+		int value{};
+		o1::s_linked::node_t<Item> node{this};
+	};
+
+	o1::s_linked::node_t<Item>* getItemNode(Item* item) {
+		return &item->node;
+	}
+
+	TEST(o1_s_linked, Sort) {
+		o1::s_linked::list_t<Item> list(getItemNode);
+		Item items[100];
+		for (int i = 0; i < 100; ++i) {
+			items[i].value = (i * 37) % 100;
+			list.push_back(&items[i]);
+		}
+
+		list.sort([](const Item& a, const Item& b) { return a.value < b.value; });
+		EXPECT_EQ(list.size(), 100);
+		int expected = 0;
+		for (auto i = list.begin(); i != list.end(); ++i)
+			EXPECT_EQ(i->value, expected++);
+		EXPECT_EQ(expected, 100);
+
+		// the tail is right.
+		Item last;
+		last.value = 100;
+		list.push_back(&last);
+		int count = 0;
+		for (auto i = list.begin(); i != list.end(); ++i)
+			++count;
+		EXPECT_EQ(count, 101);
+	}
+
+	TEST(o1_s_linked, SortIsStable) {
+		o1::s_linked::list list;
+		o1::s_linked::node nodes[40];
+		for (auto& node: nodes)
+			list.push_back(&node);
+
+		// order by (index % 4), nodes identified by address.
+		auto key = [&nodes](const o1::s_linked::node* node) { return (node - nodes) % 4; };
+		list.sort([&key](const o1::s_linked::node* a, const o1::s_linked::node* b) { return key(a) < key(b); });
+
+		const o1::s_linked::node* last = nullptr;
+		for (auto node = list.start(); node != nullptr; node = node->next()) {
+			if (last != nullptr) {
+				EXPECT_LE(key(last), key(node));
+				if (key(last) == key(node)) {
+					EXPECT_LT(last, node);
+				}
+			}
+			last = node;
+		}
+	}
+
+	TEST(o1_s_linked, Merge) {
+		o1::s_linked::list_t<Item> left(getItemNode), right(getItemNode);
+		Item items[10];
+		for (int i = 0; i < 10; ++i) {
+			items[i].value = i / 2;
+			// ties: evens on the left, odds on the right.
+			(i % 2 == 0 ? left : right).push_back(&items[i]);
+		}
+
+		left.merge(right, [](const Item& a, const Item& b) { return a.value < b.value; });
+		EXPECT_TRUE(right.empty());
+		EXPECT_EQ(left.size(), 10);
+
+		int index = 0;
+		for (auto i = left.begin(); i != left.end(); ++i)
+			EXPECT_EQ(&*i, &items[index++]);
+		EXPECT_EQ(index, 10);
+
+		// the tail is right.
+		Item last;
+		left.push_back(&last);
+		EXPECT_EQ(items[9].node.next(), &last.node);
+	}
+
+	static_assert(
+		std::is_same<
+			std::iterator_traits<o1::s_linked::list_t<Item>::iterator>::iterator_category,
+			std::forward_iterator_tag
+		>::value,
+		"s_linked::list_t iterators are forward only"
+	);
+
+	TEST(o1_s_linked, StdAlgorithms) {
+		o1::s_linked::list_t<Item> list(getItemNode);
+		Item items[10];
+		for (int i = 0; i < 10; ++i) {
+			items[i].value = i;
+			list.push_back(&items[i]);
+		}
+
+		auto found = std::find_if(list.begin(), list.end(), [](const Item& item) { return item.value == 7; });
+		EXPECT_EQ(found.get(), &items[7]);
+
+		const auto& clist = list;
+		EXPECT_EQ(std::count_if(clist.begin(), clist.end(), [](const Item& item) { return item.value > 4; }), 5);
+		EXPECT_EQ(std::distance(clist.cbegin(), clist.cend()), 10);
+	}
+
 }
@@ -35,6 +35,7 @@
 #ifndef O1CPPLIB_O1_S_LINKED_LIST_T_HH
 #define O1CPPLIB_O1_S_LINKED_LIST_T_HH
 
+#include <functional>
 #include "./o1.s_linked.list.hh"
 #include "../node/o1.s_linked.node_t.hh"
 #include "../iterator/o1.forward_iterator_ref.hh"
@@ -49,6 +50,8 @@ namespace o1 {
 		public:
 			using node = list::node;
 			using getNodeFn = typename o1::s_linked::node_t<T>::getNodeFn;
+			using iterator = o1::forward_iterator_ref<node_t<T>, T>;
+			using const_iterator = o1::forward_iterator_ref<const node_t<T>, const T>;
 
 		private:
 			getNodeFn getNode{nullptr};
@@ -69,22 +72,26 @@ namespace o1 {
 
 			~list_t() = default;
 
-			o1::forward_iterator_ref<list::node, T> begin() {
-				return o1::forward_iterator_ref<list::node, T>(
-					static_cast<node_t<T>*>(
-						list::start()
-					)
-				);
+			iterator begin() {
+				return iterator(static_cast<node_t<T>*>(list::start()));
 			}
 
-			o1::forward_iterator_ref<list::node, T> end() {
-				return o1::forward_iterator_ref<list::node, T>(
-					static_cast<node_t<T>*>(
-						nullptr
-					)
-				);
+			iterator end() {
+				return iterator(nullptr);
+			}
+
+			const_iterator begin() const {
+				return const_iterator(static_cast<const node_t<T>*>(list::start()));
 			}
 
+			const_iterator end() const {
+				return const_iterator(nullptr);
+			}
+
+			const_iterator cbegin() const { return begin(); }
+
+			const_iterator cend() const { return end(); }
+
 			using s_linked::list::empty;
 
 			/**
@@ -116,6 +123,53 @@ namespace o1 {
 				);
 			}
 
+			using s_linked::list::size;
+
+			/**
+			 * "Alias" of s_linked::splice(other).
+			 * Moves all the elements of @param other to the end of the list.
+			 */
+			void splice(list_t& other) {
+				s_linked::list::splice(other);
+			}
+
+			/**
+			 * "Alias" of s_linked::split_after(node, tail).
+			 * Moves the elements following @param datum into @param tail.
+			 */
+			void split_after(T* datum, list_t& tail) {
+				s_linked::list::split_after(getNode(datum), tail);
+			}
+
+			/**
+			 * "Alias" of s_linked::push_back_chain(first, last, count).
+			 */
+			void push_back_chain(T* first, T* last, size_t count) {
+				s_linked::list::push_back_chain(getNode(first), getNode(last), count);
+			}
+
+			/**
+			 * Stable sort of the elements, by @param less; see
+			 * s_linked::list::sort().
+			 */
+			template <typename Less = std::less<T>>
+			void sort(Less less = Less()) {
+				s_linked::list::sort([&less](const node* a, const node* b) {
+					return less(*static_cast<const node_t<T>*>(a)->ref(), *static_cast<const node_t<T>*>(b)->ref());
+				});
+			}
+
+			/**
+			 * Merges the elements of @param other, both lists sorted by
+			 * @param less; see s_linked::list::merge().
+			 */
+			template <typename Less = std::less<T>>
+			void merge(list_t& other, Less less = Less()) {
+				s_linked::list::merge(other, [&less](const node* a, const node* b) {
+					return less(*static_cast<const node_t<T>*>(a)->ref(), *static_cast<const node_t<T>*>(b)->ref());
+				});
+			}
+
 		};
 
 	}
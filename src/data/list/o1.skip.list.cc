@@ -0,0 +1,127 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#include "o1.skip.list.hh"
+#include "../../o1.logging.hh"
+
+using o1::skip::list;
+using node = o1::skip::list::node;
+
+list::list():
+	_seed(reinterpret_cast<uintptr_t>(this) * 0x9e3779b97f4a7c15ULL | 1) {
+}
+
+list::~list() {
+	flush();
+}
+
+void list::flush() {
+	for (node* n = _head.next(); n != &_head; ) {
+		node* next = n->next();
+		n->_list = nullptr;
+		n->_levels = 0;
+		n->loop();
+		n = next;
+	}
+	_head.loop();
+	_size = 0;
+	_levels = 1;
+}
+
+unsigned list::randomLevels(unsigned capacity) {
+	// xorshift64*
+	_seed ^= _seed >> 12;
+	_seed ^= _seed << 25;
+	_seed ^= _seed >> 27;
+	uint64_t bits = _seed * 0x2545f4914f6cdd1dULL;
+
+	unsigned levels = 1;
+	while (levels < capacity && (bits & 3) == 0) {
+		++levels;
+		bits >>= 2;
+	}
+	return levels;
+}
+
+void list::link(node* tower, node** preds, unsigned levels) {
+	o1::xassert(tower->_list == nullptr, "o1::skip::list::link: node is already on a list");
+	o1::xassert(levels <= tower->_capacity, "o1::skip::list::link: node is not that tall");
+
+	for (; _levels < levels; ++_levels)
+		preds[_levels] = &_head;
+
+	for (unsigned level = 0; level < levels; ++level) {
+		auto prev = preds[level];
+		auto next = prev->_links[level].next;
+		tower->_links[level] = { next, prev };
+		prev->_links[level].next = tower;
+		next->_links[level].prev = tower;
+	}
+
+	tower->_list = this;
+	tower->_levels = levels;
+	++_size;
+}
+
+void list::unlink(node* tower) {
+	for (unsigned level = 0; level < tower->_levels; ++level) {
+		auto& link = tower->_links[level];
+		link.prev->_links[level].next = link.next;
+		link.next->_links[level].prev = link.prev;
+		link.next = link.prev = tower;
+	}
+
+	while (_levels > 1 && _head._links[_levels - 1].next == &_head)
+		--_levels;
+
+	tower->_list = nullptr;
+	tower->_levels = 0;
+	--_size;
+}
+
+node* list::pop_front() {
+	node* ret = _head.next();
+	if (ret == &_head)
+		return nullptr;
+	unlink(ret);
+	return ret;
+}
+
+node* list::pop_back() {
+	node* ret = _head.prev();
+	if (ret == &_head)
+		return nullptr;
+	unlink(ret);
+	return ret;
+}
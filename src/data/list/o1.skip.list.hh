@@ -0,0 +1,156 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#ifndef O1CPPLIB_O1_SKIP_LIST_HH
+#define O1CPPLIB_O1_SKIP_LIST_HH
+
+#include <cstddef>
+#include <cstdint>
+#include "../node/o1.skip.node.hh"
+
+namespace o1 {
+
+	namespace skip {
+
+		/**
+		 * Untyped part of a skip list (see list_t): the
+		 * sentinel tower, linking and unlinking of nodes.
+		 *
+		 * Ordering (hence searching) is left to the typed list; this one
+		 * only links a node after the predecessors it's given, one per
+		 * level.
+		 *
+		 * Nodes point to their list, so lists can't be moved.
+		 */
+		class list {
+		public:
+			using node = o1::skip::node;
+
+		private:
+			friend node;
+
+			/**
+			 * Sentinel: every level of it starts and ends the list.
+			 */
+			tower<node::maxLevels> _head;
+			size_t _size{0};
+			unsigned _levels{1};
+			uint64_t _seed;
+
+			/**
+			 * O(levels of @param tower), expected O(1).
+			 */
+			void unlink(node* tower);
+
+		protected:
+
+			/**
+			 * @return a random tower height, in [1, @param capacity].
+			 */
+			unsigned randomLevels(unsigned capacity = node::maxLevels);
+
+			/**
+			 * Links @param tower, of @param levels (up to its capacity),
+			 * after @param preds[i] on each level i; predecessors above
+			 * the current height of the list need not be set.
+			 */
+			void link(node* tower, node** preds, unsigned levels);
+
+		public:
+			list();
+
+			list(const list& that) = delete;
+
+			list(list&& that) = delete;
+
+			/**
+			 * Upon destruction, nodes are NOT deleted, just unlinked.
+			 */
+			virtual ~list();
+
+			/**
+			 * Remove all nodes from the list, NOT deleting them.
+			 * O(n).
+			 */
+			void flush();
+
+			/**
+			 * @return the height of the tallest tower in the list.
+			 */
+			[[nodiscard]] inline unsigned levels() const { return _levels; }
+
+			[[nodiscard]] inline size_t size() const { return _size; }
+
+			[[nodiscard]] inline bool empty() const { return _size == 0; }
+
+			/**
+			 * @return the first node of the list, or finish() if it's empty.
+			 */
+			[[nodiscard]] inline const node* start() const { return _head.next(); }
+
+			[[nodiscard]] inline node* start() { return _head.next(); }
+
+			/**
+			 * @return the last node of the list, or finish() if it's empty.
+			 */
+			[[nodiscard]] inline const node* r_start() const { return _head.prev(); }
+
+			[[nodiscard]] inline node* r_start() { return _head.prev(); }
+
+			/**
+			 * When a node equals to the returned value, list traversal has ended.
+			 */
+			[[nodiscard]] inline const node* finish() const { return &_head; }
+
+			[[nodiscard]] inline node* finish() { return &_head; }
+
+			/**
+			 * Removes (and returns) the first node of the list.
+			 * @return the removed node, nullptr if the list is empty.
+			 */
+			node* pop_front();
+
+			/**
+			 * Removes (and returns) the last node of the list.
+			 * @return the removed node, nullptr if the list is empty.
+			 */
+			node* pop_back();
+
+		};
+
+	}
+
+}
+
+#endif //O1CPPLIB_O1_SKIP_LIST_HH
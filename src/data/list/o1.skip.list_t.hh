@@ -0,0 +1,320 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#ifndef O1CPPLIB_O1_SKIP_LIST_T_HH
+#define O1CPPLIB_O1_SKIP_LIST_T_HH
+
+#include <functional>
+#include "./o1.skip.list.hh"
+#include "../node/o1.skip.node_t.hh"
+#include "../iterator/o1.forward_iterator_ref.hh"
+#include "../iterator/o1.backward_iterator_ref.hh"
+#include "../../o1.debug.hh"
+#include "../../o1.logging.hh"
+
+namespace o1 {
+
+	namespace skip {
+
+		/**
+		 * Ordered intrusive container: a skip list of T, each one
+		 * embedding a skip::node_t<T>.
+		 *
+		 * - insert, find, lower_bound, upper_bound: O(log n) expected;
+		 * - remove (given the element), pop_front, pop_back: O(1) expected;
+		 * - ordered traversal (both ways) from any element.
+		 *
+		 * Equal elements are kept in insertion order.  Just like
+		 * d_linked lists, destroying an element detaches it.
+		 *
+		 * @tparam Less strict weak ordering of T; lookups by a Key other
+		 *         than T need Less to compare T to Key both ways.
+		 * @tparam Levels maximum tower height of the nodes (see
+		 *         skip::node_t).
+		 */
+		template <typename T, typename Less = std::less<T>, unsigned Levels = node::maxLevels>
+		class list_t: public o1::skip::list {
+
+		public:
+
+			using node_t = o1::skip::node_t<T, Levels>;
+			using getNodeFn = typename node_t::getNodeFn;
+			using iterator = o1::forward_iterator_ref<node_t, T>;
+			using const_iterator = o1::forward_iterator_ref<const node_t, const T>;
+			using reverse_iterator = o1::backward_iterator_ref<node_t, T>;
+			using const_reverse_iterator = o1::backward_iterator_ref<const node_t, const T>;
+
+		private:
+			getNodeFn getNode{nullptr};
+			Less _less;
+
+			/**
+			 * All nodes but the sentinel (finish()) are node_t.
+			 */
+			inline node_t* typed(node* node) {
+				return node == finish() ? nullptr : static_cast<node_t*>(node);
+			}
+
+			inline const node_t* typed(const node* node) const {
+				return node == finish() ? nullptr : static_cast<const node_t*>(node);
+			}
+
+			static inline const T& datum(node* node) {
+				return *static_cast<node_t*>(node)->ref();
+			}
+
+			/**
+			 * @return the first node not less than @param key (finish()
+			 *         if there's none).
+			 * @param preds if not null, set to the last node less than
+			 *        @param key, on each level.
+			 */
+			template <typename Key>
+			node* lowerBound(const Key& key, node** preds = nullptr) {
+				node* x = finish();
+				for (unsigned level = levels(); level-- > 0; ) {
+					node* next;
+					while ((next = x->next(level)) != finish() && _less(datum(next), key))
+						x = next;
+					if (preds != nullptr)
+						preds[level] = x;
+				}
+				return x->next();
+			}
+
+			/**
+			 * @return the first node greater than @param key (finish()
+			 *         if there's none).
+			 * @param preds if not null, set to the last node not greater
+			 *        than @param key, on each level.
+			 */
+			template <typename Key>
+			node* upperBound(const Key& key, node** preds = nullptr) {
+				node* x = finish();
+				for (unsigned level = levels(); level-- > 0; ) {
+					node* next;
+					while ((next = x->next(level)) != finish() && !_less(key, datum(next)))
+						x = next;
+					if (preds != nullptr)
+						preds[level] = x;
+				}
+				return x->next();
+			}
+
+		public:
+
+			list_t() = delete;
+
+			explicit list_t(getNodeFn _getNode, Less less = Less()):
+				getNode(_getNode),
+				_less(less) {
+			}
+
+			list_t(const list_t& that) = delete;
+
+			list_t(list_t&& that) = delete;
+
+			~list_t() override = default;
+
+			/**
+			 * Remove all elements from the list, deleting them.
+			 */
+			void clear() {
+				while (auto element = pop_front())
+					delete element;
+			}
+
+			/**
+			 * Adds @param datum after the elements not greater than it.
+			 * O(log n) expected.
+			 */
+			void insert(T* datum) {
+				node* preds[node::maxLevels];
+				upperBound(*datum, preds);
+				link(getNode(datum), preds, randomLevels(Levels));
+			}
+
+			/**
+			 * Adds @param datum, unless there's an equal element already.
+			 * O(log n) expected.
+			 * @return true if it was added.
+			 */
+			bool insert_unique(T* datum) {
+				node* preds[node::maxLevels];
+				node* found = lowerBound(*datum, preds);
+				if (found != finish() && !_less(*datum, this->datum(found)))
+					return false;
+				link(getNode(datum), preds, randomLevels(Levels));
+				return true;
+			}
+
+			/**
+			 * Removes @param datum, NOT deleting it.
+			 * O(1) expected.
+			 */
+			void remove(T* datum) {
+				node* node = getNode(datum);
+				if (o1::flags::extended_checks()) {
+					o1::xassert(
+						node->owner() == this,
+						"o1::skip::list_t::remove: element is not on this list"
+					);
+				}
+				node->detach();
+			}
+
+			/**
+			 * @return the first element equal to @param key, nullptr if
+			 *         there's none.
+			 */
+			template <typename Key>
+			T* find(const Key& key) {
+				node* found = lowerBound(key);
+				if (found == finish() || _less(key, datum(found)))
+					return nullptr;
+				return static_cast<node_t*>(found)->ref();
+			}
+
+			template <typename Key>
+			bool contains(const Key& key) {
+				return find(key) != nullptr;
+			}
+
+			/**
+			 * @return iterator to the first element not less than @param key.
+			 */
+			template <typename Key>
+			iterator lower_bound(const Key& key) {
+				return iterator(typed(lowerBound(key)), finish());
+			}
+
+			/**
+			 * @return iterator to the first element greater than @param key.
+			 */
+			template <typename Key>
+			iterator upper_bound(const Key& key) {
+				return iterator(typed(upperBound(key)), finish());
+			}
+
+			/**
+			 * @return the smallest element, nullptr if the list is empty.
+			 */
+			T* front() {
+				return node_t::ref(typed(list::start()));
+			}
+
+			/**
+			 * @return the greatest element, nullptr if the list is empty.
+			 */
+			T* back() {
+				return node_t::ref(typed(list::r_start()));
+			}
+
+			T* pop_front() {
+				return node_t::ref(static_cast<node_t*>(list::pop_front()));
+			}
+
+			T* pop_back() {
+				return node_t::ref(static_cast<node_t*>(list::pop_back()));
+			}
+
+			/**
+			 * @return iterator starting at @param datum (which must be on
+			 *         this list).
+			 */
+			iterator at(T* datum) {
+				return iterator(getNode(datum), finish());
+			}
+
+			iterator begin() {
+				return iterator(typed(list::start()), finish());
+			}
+
+			iterator end() {
+				return iterator(nullptr, finish());
+			}
+
+			const_iterator begin() const {
+				return const_iterator(typed(list::start()), finish());
+			}
+
+			const_iterator end() const {
+				return const_iterator(nullptr, finish());
+			}
+
+			const_iterator cbegin() const { return begin(); }
+
+			const_iterator cend() const { return end(); }
+
+			reverse_iterator rbegin() {
+				return reverse_iterator(typed(list::r_start()), finish());
+			}
+
+			reverse_iterator rend() {
+				return reverse_iterator(nullptr, finish());
+			}
+
+			const_reverse_iterator rbegin() const {
+				return const_reverse_iterator(typed(list::r_start()), finish());
+			}
+
+			const_reverse_iterator rend() const {
+				return const_reverse_iterator(nullptr, finish());
+			}
+
+			/**
+			 * Removes (NOT deleting) the element at @param position, for
+			 * erasing while iterating.
+			 * @return iterator to the next element.
+			 */
+			iterator erase(iterator position) {
+				T* datum = position.get();
+				++position;
+				remove(datum);
+				return position;
+			}
+
+		};
+
+	}
+
+	/**
+	 * Intrusive skip list, see skip::list_t.
+	 */
+	template <typename T, typename Less = std::less<T>, unsigned Levels = skip::node::maxLevels>
+	using skip_list = o1::skip::list_t<T, Less, Levels>;
+
+}
+
+#endif //O1CPPLIB_O1_SKIP_LIST_T_HH
@@ -0,0 +1,183 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+#include "o1.skip.list_t.hh"
+#include "../o1.ordered.test_fixture.hh"
+
+namespace {
+
+	template <typename T>
+	using skip_node = o1::skip::node_t<T>;
+
+	using Item = o1::test::item<skip_node>;
+	using skip_list = o1::skip_list<Item, o1::test::ByKey>;
+	using o1::test::keys;
+
+	/**
+	 * @return the height of the tallest tower among @param items still
+	 *         linked (at least 1, the list's own).
+	 */
+	template <typename Element>
+	unsigned tallest(const std::vector<Element>& items) {
+		unsigned ret = 1;
+		for (auto& item: items)
+			ret = std::max(ret, item.node.levels());
+		return ret;
+	}
+
+	TEST(o1_skip_list, Remove) {
+		skip_list list(Item::getNode);
+		std::vector<Item> items(100);
+		for (int i = 0; i < 100; ++i) {
+			items[i].key = i;
+			list.insert(&items[i]);
+		}
+
+		for (int i = 0; i < 100; i += 2)
+			list.remove(&items[i]);
+
+		EXPECT_EQ(list.size(), 50);
+		EXPECT_FALSE(items[0].node.linked());
+		EXPECT_EQ(items[0].node.levels(), 0u);
+		EXPECT_TRUE(items[1].node.linked());
+		EXPECT_EQ(list.find(10), nullptr);
+		EXPECT_EQ(list.find(11), &items[11]);
+		EXPECT_EQ(list.pop_front(), &items[1]);
+		EXPECT_EQ(list.pop_back(), &items[99]);
+		EXPECT_EQ(list.size(), 48);
+
+		// removed elements may be inserted again.
+		list.insert(&items[0]);
+		EXPECT_EQ(list.front(), &items[0]);
+	}
+
+	TEST(o1_skip_list, LevelDistribution) {
+		skip_list list(Item::getNode);
+		std::vector<Item> items(4096);
+		for (size_t i = 0; i < items.size(); ++i) {
+			items[i].key = int(i);
+			list.insert(&items[i]);
+		}
+
+		// 1/4 promotion rate.
+		size_t promoted = 0;
+		for (auto& item: items)
+			promoted += item.node.levels() > 1;
+		EXPECT_GT(promoted, items.size() / 5);
+		EXPECT_LT(promoted, items.size() / 3);
+
+		EXPECT_GT(list.levels(), 3u);
+		EXPECT_EQ(list.levels(), tallest(items));
+	}
+
+	TEST(o1_skip_list, LevelsShrinkOnUnlink) {
+		skip_list list(Item::getNode);
+		std::vector<Item> items(4096);
+		for (size_t i = 0; i < items.size(); ++i) {
+			items[i].key = int((i * 1031) % items.size());
+			list.insert(&items[i]);
+		}
+
+		// tallest towers first, some removed through the list, some
+		// detaching on their own.
+		std::vector<Item*> byHeight;
+		for (auto& item: items)
+			byHeight.push_back(&item);
+		std::stable_sort(byHeight.begin(), byHeight.end(), [](const Item* a, const Item* b) {
+			return a->node.levels() > b->node.levels();
+		});
+
+		for (size_t i = 0; i < byHeight.size() && byHeight[i]->node.levels() > 1; ++i) {
+			if (i % 2)
+				list.remove(byHeight[i]);
+			else
+				byHeight[i]->node.detach();
+			ASSERT_EQ(list.levels(), tallest(items)) << "i=" << i;
+		}
+
+		EXPECT_EQ(list.levels(), 1u);
+		EXPECT_TRUE(std::is_sorted(list.begin(), list.end(), o1::test::ByKey()));
+
+		list.flush();
+		EXPECT_EQ(list.levels(), 1u);
+	}
+
+	template <unsigned Levels>
+	struct short_node {
+		template <typename T>
+		using type = o1::skip::node_t<T, Levels>;
+	};
+
+	/**
+	 * Lists of towers up to @tparam Levels high.
+	 */
+	template <unsigned Levels>
+	void expectShortTowers() {
+		using short_item = o1::test::item<short_node<Levels>::template type>;
+
+		EXPECT_EQ(
+			sizeof(o1::skip::node_t<short_item>) - sizeof(typename short_item::node_t),
+			(o1::skip::node::maxLevels - Levels) * 2 * sizeof(void*)
+		);
+
+		o1::skip_list<short_item, o1::test::ByKey, Levels> list(short_item::getNode);
+		std::vector<short_item> items(4096);
+		std::vector<int> expected;
+		for (size_t i = 0; i < items.size(); ++i) {
+			auto& item = items[(i * 1031) % items.size()];
+			item.key = int(i);
+			expected.push_back(int(i));
+			list.insert(&item);
+		}
+
+		for (auto& item: items) {
+			EXPECT_EQ(item.node.capacity(), Levels);
+			EXPECT_GE(item.node.levels(), 1u);
+			EXPECT_LE(item.node.levels(), Levels);
+		}
+
+		EXPECT_EQ(list.levels(), Levels);
+		EXPECT_EQ(keys(list), expected);
+	}
+
+	TEST(o1_skip_list, ShortTowers) {
+		expectShortTowers<1>();
+		expectShortTowers<2>();
+		expectShortTowers<4>();
+	}
+
+}
@@ -0,0 +1,143 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#ifndef O1CPPLIB_O1_CHUNKED_BLOCK_T_HH
+#define O1CPPLIB_O1_CHUNKED_BLOCK_T_HH
+
+#include <cstddef>
+#include "../../memory/pool/o1.memory.pooled.hh"
+
+namespace o1 {
+
+	namespace chunked {
+
+		/**
+		 * Fixed size array of T pointers, linked to the next block.
+		 * Blocks come from the o1::memory chunked pool, which is shared
+		 * by all the containers using the same T & Items (and is not
+		 * thread safe).
+		 */
+		template <typename T, size_t Items>
+		class block_t:
+			public o1::memory::pooled<block_t<T, Items>, o1::memory::PoolStrategy::chunkedAlloc> {
+		public:
+			static_assert(Items > 0, "o1::chunked::block_t: Items must be positive");
+
+			block_t* next{nullptr};
+			T* slots[Items];
+		};
+
+		/**
+		 * Blocks owner: up to maxSpareBlocks released blocks are kept on a
+		 * free list (linked through block_t::next) and handed out again
+		 * before going back to the pool.
+		 */
+		template <typename T, size_t Items>
+		class blocks_t {
+		public:
+			using block = o1::chunked::block_t<T, Items>;
+
+			static const constexpr size_t maxSpareBlocks = 4;
+
+		private:
+			block* _spare{nullptr};
+			size_t _spareCount{0};
+
+		protected:
+
+			block* acquire() {
+				block* ret = _spare;
+				if (ret == nullptr)
+					return new block();
+
+				_spare = ret->next;
+				--_spareCount;
+				ret->next = nullptr;
+				return ret;
+			}
+
+			void release(block* b) {
+				if (_spareCount == maxSpareBlocks) {
+					delete b;
+					return;
+				}
+
+				b->next = _spare;
+				_spare = b;
+				++_spareCount;
+			}
+
+		public:
+			blocks_t() = default;
+
+			blocks_t(const blocks_t& that) = delete;
+
+			blocks_t(blocks_t&& that) noexcept:
+				_spare(that._spare),
+				_spareCount(that._spareCount) {
+				that._spare = nullptr;
+				that._spareCount = 0;
+			}
+
+			~blocks_t() {
+				shrink();
+			}
+
+			/**
+			 * @return number of blocks on the free list.
+			 */
+			[[nodiscard]] inline size_t spare() const { return _spareCount; }
+
+			/**
+			 * Gives the blocks on the free list back to the pool.
+			 */
+			void shrink() {
+				while (_spare != nullptr) {
+					block* next = _spare->next;
+					delete _spare;
+					_spare = next;
+				}
+				_spareCount = 0;
+			}
+
+		};
+
+		template <typename T, size_t Items>
+		const constexpr size_t blocks_t<T, Items>::maxSpareBlocks;
+
+	}
+
+}
+
+#endif //O1CPPLIB_O1_CHUNKED_BLOCK_T_HH
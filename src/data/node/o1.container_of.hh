@@ -0,0 +1,69 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#ifndef O1CPPLIB_O1_CONTAINER_OF_HH
+#define O1CPPLIB_O1_CONTAINER_OF_HH
+
+#include <cstddef>
+#include <cstdint>
+
+namespace o1 {
+
+	/**
+	 * @return the offset of @param member within T.
+	 * T must not have virtual bases.
+	 */
+	template <typename T, typename M>
+	inline size_t offset_of(M T::*member) {
+		// any (suitably aligned) non null address does.
+		const uintptr_t base = 0x1000;
+		return reinterpret_cast<uintptr_t>(&(reinterpret_cast<const T*>(base)->*member)) - base;
+	}
+
+	/**
+	 * @return the object whose @param member is @param ptr.
+	 */
+	template <typename T, typename M>
+	inline T* container_of(M* ptr, M T::*member) {
+		return reinterpret_cast<T*>(reinterpret_cast<char*>(ptr) - offset_of(member));
+	}
+
+	template <typename T, typename M>
+	inline const T* container_of(const M* ptr, M T::*member) {
+		return reinterpret_cast<const T*>(reinterpret_cast<const char*>(ptr) - offset_of(member));
+	}
+
+}
+
+#endif //O1CPPLIB_O1_CONTAINER_OF_HH
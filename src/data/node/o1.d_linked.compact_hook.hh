@@ -0,0 +1,125 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#ifndef O1CPPLIB_O1_D_LINKED_COMPACT_HOOK_HH
+#define O1CPPLIB_O1_D_LINKED_COMPACT_HOOK_HH
+
+#include <cstddef>
+#include <cstdint>
+#include "../../o1.logging.hh"
+
+namespace o1 {
+
+	namespace d_linked {
+
+		class compact_hook;
+
+		template <typename T, compact_hook T::*member>
+		class compact_hook_list;
+
+		/**
+		 * Intrusive double linked list hook of two 32-bit links: each
+		 * one is the distance to the neighbour hook, in units of
+		 * alignof(compact_hook) (4 bytes), relative to the hook itself.
+		 *
+		 * Meant for objects living close to each other, such as the ones
+		 * allocated from o1::memory::chunk<T> pools: hooks on the same
+		 * list must be less than 8GiB apart (checked when linking).
+		 *
+		 * Like hook<false>, a compact_hook must be unlinked through its
+		 * list (compact_hook_list), and not be destroyed while linked.
+		 */
+		class compact_hook {
+			template <typename T, compact_hook T::*member>
+			friend class compact_hook_list;
+
+			using offset_t = int32_t;
+
+			// No neighbour (first / last hook of a list).
+			static const constexpr offset_t none = 0;
+
+			// Not on a list.
+			static const constexpr offset_t unlinked = INT32_MIN;
+
+			static const constexpr ptrdiff_t unit = sizeof(offset_t);
+
+			offset_t _next{unlinked};
+			offset_t _prev{unlinked};
+
+			inline compact_hook* at(offset_t offset) {
+				return offset == none ?
+					nullptr :
+					reinterpret_cast<compact_hook*>(reinterpret_cast<char*>(this) + offset * unit);
+			}
+
+			inline offset_t offsetOf(compact_hook* that) {
+				if (that == nullptr)
+					return none;
+				ptrdiff_t distance = (reinterpret_cast<char*>(that) - reinterpret_cast<char*>(this)) / unit;
+				o1::xassert(
+					distance > INT32_MIN && distance <= INT32_MAX,
+					"o1::d_linked::compact_hook: hooks %td bytes apart",
+					distance * unit
+				);
+				return offset_t(distance);
+			}
+
+			inline compact_hook* next() { return at(_next); }
+
+			inline compact_hook* prev() { return at(_prev); }
+
+			inline void setNext(compact_hook* that) { _next = offsetOf(that); }
+
+			inline void setPrev(compact_hook* that) { _prev = offsetOf(that); }
+
+		public:
+
+			compact_hook() = default;
+
+			compact_hook(const compact_hook& that) = delete;
+
+			compact_hook& operator = (const compact_hook& that) = delete;
+
+			/**
+			 * @return true if the hook is on a list.
+			 */
+			inline bool linked() const { return _next != unlinked; }
+
+		};
+
+	}
+
+}
+
+#endif //O1CPPLIB_O1_D_LINKED_COMPACT_HOOK_HH
@@ -0,0 +1,127 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#ifndef O1CPPLIB_O1_D_LINKED_HOOK_HH
+#define O1CPPLIB_O1_D_LINKED_HOOK_HH
+
+namespace o1 {
+
+	namespace d_linked {
+
+		template <typename T, typename Hook, Hook T::*member>
+		class hook_list;
+
+		/**
+		 * Lean intrusive double linked list hook: two raw pointers, no
+		 * vtable, no event handlers (see hook_list).
+		 *
+		 * Unlike d_linked::node, the list keeps its own size, so hooks
+		 * must be unlinked through their list; a normal hook must not be
+		 * destroyed while linked.
+		 *
+		 * @tparam AutoUnlink if true, the hook unlinks itself when
+		 *         destroyed (and may be unlinked on its own, see unlink());
+		 *         the list it was on can't keep its size then, so
+		 *         hook_list::size() becomes O(n).
+		 */
+		template <bool AutoUnlink = false>
+		class hook {
+			template <typename T, typename Hook, Hook T::*member>
+			friend class hook_list;
+
+			hook* _next{nullptr};
+			hook* _prev{nullptr};
+
+			/**
+			 * Inserts *this before @param at.
+			 */
+			inline void linkBefore(hook* at) {
+				_next = at;
+				_prev = at->_prev;
+				_prev->_next = this;
+				at->_prev = this;
+			}
+
+			inline void _unlink() {
+				_prev->_next = _next;
+				_next->_prev = _prev;
+				_next = _prev = nullptr;
+			}
+
+		public:
+
+			static const constexpr bool autoUnlink = AutoUnlink;
+
+			hook() = default;
+
+			hook(const hook& that) = delete;
+
+			hook& operator = (const hook& that) = delete;
+
+			~hook() {
+				if (AutoUnlink && linked())
+					_unlink();
+			}
+
+			/**
+			 * @return true if the hook is on a list.
+			 */
+			inline bool linked() const { return _next != nullptr; }
+
+			/**
+			 * Removes the hook from whatever list it is on (auto-unlink
+			 * hooks only).
+			 */
+			template <bool enabled = AutoUnlink>
+			void unlink() {
+				static_assert(enabled, "o1::d_linked::hook::unlink: only auto-unlink hooks can leave their list on their own");
+				if (linked())
+					_unlink();
+			}
+
+		};
+
+		template <bool AutoUnlink>
+		const constexpr bool hook<AutoUnlink>::autoUnlink;
+
+		/**
+		 * Hook that unlinks itself when destroyed.
+		 */
+		using auto_unlink_hook = hook<true>;
+
+	}
+
+}
+
+#endif //O1CPPLIB_O1_D_LINKED_HOOK_HH
@@ -39,20 +39,97 @@
 
 using node = o1::d_linked::node;
 
+/**
+ * Set once this thread's pool is gone: cells released afterwards (by
+ * static or other thread_local lists) get deleted instead. Trivially
+ * destructible, so it remains usable through the thread's exit.
+ */
+static thread_local bool poolDestroyed = false;
+
+/**
+ * Released membership cells, per thread.
+ */
+struct node::membership::pool {
+	membership* head{nullptr};
+
+	~pool() {
+		poolDestroyed = true;
+		while (auto cell = head) {
+			head = cell->_nextFree;
+			delete cell;
+		}
+	}
+};
+
+static thread_local node::membership::pool freeCells;
+
+node::membership* node::membership::acquire(EventHandlers* handlers) {
+	membership* cell = poolDestroyed ? nullptr : freeCells.head;
+	if (cell != nullptr) {
+		freeCells.head = cell->_nextFree;
+	} else {
+		cell = new membership();
+	}
+	cell->_handlers = handlers;
+	cell->_refs = 1;
+	cell->_nextFree = nullptr;
+	return cell;
+}
+
+void node::membership::release() {
+	if (--_refs != 0)
+		return;
+	membership* forward = _forward;
+	_forward = nullptr;
+	_handlers = nullptr;
+	if (poolDestroyed) {
+		delete this;
+	} else {
+		_nextFree = freeCells.head;
+		freeCells.head = this;
+	}
+	if (forward != nullptr)
+		forward->release();
+}
+
+node::membership* node::membership::root() {
+	membership* ret = this;
+	while (ret->_forward != nullptr)
+		ret = ret->_forward;
+
+	if (_forward != ret) {
+		ret->retain();
+		_forward->release();
+		_forward = ret;
+	}
+
+	return ret;
+}
+
+void node::membership::forwardTo(membership* target) {
+	target = target->_forward == nullptr ? target : target->root();
+	if (target == this)
+		return;
+	target->retain();
+	if (_forward != nullptr)
+		_forward->release();
+	_forward = target;
+	_handlers = nullptr;
+}
+
 node::node() {
 	_next = _prev = this;
-	_handlers = nullptr;
 }
 
-node::node(std::shared_ptr<node::EventHandlers> handlers):
-	_handlers(std::move(handlers)) {
+node::node(membership* cell) {
 	_next = _prev = this;
+	setMembership(cell);
 }
 
 node::node(class node&& that) noexcept:
 	_next(that._next),
 	_prev(that._prev),
-	_handlers(std::move(that._handlers)) {
+	_membership(that._membership) {
 
 	if (that._prev == &that) {
 		_prev = this;
@@ -67,24 +144,40 @@ node::node(class node&& that) noexcept:
 	}
 
 	that._next = that._prev = &that;
+	that._membership = nullptr;
+}
+
+node::~node() {
+	detach();
+	setMembership(nullptr);
 }
 
+void node::setMembership(membership* cell) {
+	if (cell != nullptr)
+		cell->retain();
+	if (_membership != nullptr)
+		_membership->release();
+	_membership = cell;
+}
 
 void
 node::detach() {
 	if (!empty()) {
+		auto handlers = _membership == nullptr ? nullptr : _membership->handlers();
 
-		if (_handlers != nullptr)
-			_handlers->detaching(this);
+		if (handlers != nullptr)
+			handlers->detaching(this);
 
+		node* other = _next;
 		_next->_prev = _prev;
 		_prev->_next = _next;
 		_prev = _next = this;
 
-		if (_handlers != nullptr)
-			_handlers->detached(this);
+		if (handlers != nullptr)
+			handlers->detached(this);
 
-		_handlers = nullptr;
+		setMembership(nullptr);
+		other->releaseIfOrphan();
 	}
 }
 void
@@ -104,29 +197,31 @@ node::push_back(node* node) {
 		);
 	}
 
-	node->_handlers = _handlers;
+	node->setMembership(_membership);
+	auto handlers = _membership == nullptr ? nullptr : _membership->handlers();
 
-	if (_handlers != nullptr)
-		_handlers->attaching(node);
+	if (handlers != nullptr)
+		handlers->attaching(node);
 
 	_push_back(node);
 
-	if (_handlers != nullptr)
-		_handlers->attached(node);
+	if (handlers != nullptr)
+		handlers->attached(node);
 }
 
 
 void
 node::push_front(node* node) {
-	node->_handlers = _handlers;
+	node->setMembership(_membership);
+	auto handlers = _membership == nullptr ? nullptr : _membership->handlers();
 
-	if (_handlers != nullptr)
-		_handlers->attaching(node);
+	if (handlers != nullptr)
+		handlers->attaching(node);
 
 	node->_push_back(this);
 
-	if (_handlers != nullptr)
-		_handlers->attached(node);
+	if (handlers != nullptr)
+		handlers->attached(node);
 }
 
 bool node::empty() {
@@ -149,7 +244,18 @@ bool node::empty() const {
 	return _next == this;
 }
 
-void node::reset(std::shared_ptr<EventHandlers> handlers) {
-	_handlers = std::move(handlers);
+void node::reset(membership* cell) {
+	// the others get linked among themselves, w/out any event.
+	node* other = _next;
+	_next->_prev = _prev;
+	_prev->_next = _next;
 	_next = _prev = this;
+	setMembership(cell);
+	other->releaseIfOrphan();
+}
+
+void node::releaseIfOrphan() {
+	// a list sentinel always has handlers.
+	if (empty() && _membership != nullptr && _membership->handlers() == nullptr)
+		setMembership(nullptr);
 }
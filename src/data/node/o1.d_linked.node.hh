@@ -35,35 +35,100 @@
 #ifndef O1CPPLIB_O1_D_LINKED_NODE_HH
 #define O1CPPLIB_O1_D_LINKED_NODE_HH
 
-#include <memory>
-#include <utility>
+#include <cstddef>
 #include "../o1.event_handlers.hh"
 
 namespace o1 {
 
 	namespace d_linked {
 
+		class list;
+
 		// TODO documentation
 		class node {
 
 		public:
 			using EventHandlers = o1::NodeEventHandlers<node>;
 
+			/**
+			 * Tells the nodes which handlers (list) they belong to.
+			 *
+			 * A list and all of its nodes share one cell, so a list gets
+			 * moved, or flushed, in O(1): only the cell handlers change.
+			 * Cells are intrusively reference counted (not thread safe,
+			 * just like the lists themselves), and recycled through a
+			 * per thread free list (cells released once it's destroyed,
+			 * at thread exit, get deleted instead).
+			 *
+			 * A cell may forward to another one (see list::splice()), in
+			 * which case the handlers are the ones of the cell at the end
+			 * of the forwarding chain.
+			 */
+			class membership {
+				EventHandlers* _handlers{nullptr};
+				size_t _refs{0};
+				membership* _nextFree{nullptr};
+				membership* _forward{nullptr};
+
+				/**
+				 * @return the cell at the end of the forwarding chain,
+				 *         shortening the chain along the way.
+				 */
+				membership* root();
+
+			public:
+				struct pool;
+				friend struct pool;
+
+				/**
+				 * @return a cell with @param handlers, and one reference.
+				 */
+				static membership* acquire(EventHandlers* handlers);
+
+				inline EventHandlers* handlers() {
+					return _forward == nullptr ? _handlers : root()->_handlers;
+				}
+
+				inline void setHandlers(EventHandlers* handlers) { _handlers = handlers; }
+
+				/**
+				 * Makes the nodes of this cell members of @param target
+				 * from now on; O(1).
+				 */
+				void forwardTo(membership* target);
+
+				inline void retain() { ++_refs; }
+
+				/**
+				 * Drops a reference, recycling the cell on the last one.
+				 */
+				void release();
+			};
+
 		private:
+			friend class list;
+
 			node* _next = nullptr;
 			node* _prev = nullptr;
-			/**
-			 * We use a shared_ptr to keep list move constructor & list flush
-			 * fast (so we avoid changing it in all nodes).
-			 */
-			std::shared_ptr<EventHandlers> _handlers = nullptr;
+			membership* _membership = nullptr;
 
 			void _push_back(node* next);
 
+			void setMembership(membership* cell);
+
+			/**
+			 * Drops the membership of a node left alone, once its list
+			 * is gone (see list::flush()).
+			 */
+			void releaseIfOrphan();
+
 		public:
 			node();
 
-			explicit node(std::shared_ptr<EventHandlers> handlers);
+			/**
+			 * @param cell membership of the node (a reference is taken).
+			 */
+			explicit node(membership* cell);
 
 			node(const node& that) = delete;
 
@@ -74,13 +139,22 @@ namespace o1 {
 			 */
 			node(node&& that) noexcept;
 
-			void reset(std::shared_ptr<EventHandlers> handlers);
+			/**
+			 * Unlinks the node w/out any event (the nodes it was linked to
+			 * remain linked among themselves, keeping their membership),
+			 * and sets its membership to @param cell.
+			 */
+			void reset(membership* cell = nullptr);
+
+			/**
+			 * @return the membership of this node, nullptr if it has none.
+			 */
+			inline membership* cell() const { return _membership; }
 
 			/**
 			 * Detach this node on destructor.
-			 * Destructor is virtual, so this can be dynamic casted to subclasses.
 			 */
-			virtual ~node() { detach(); }
+			virtual ~node();
 
 			void detach();
 
@@ -0,0 +1,108 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#ifndef O1CPPLIB_O1_PAIRING_NODE_HH
+#define O1CPPLIB_O1_PAIRING_NODE_HH
+
+namespace o1 {
+
+	namespace pairing {
+
+		class heap;
+
+		/**
+		 * Pairing heap node: first child, next sibling, and previous
+		 * sibling (or parent, for a first child).
+		 *
+		 * A node removes itself from its heap when destroyed.
+		 */
+		class node {
+			friend class heap;
+
+			node* _child{nullptr};
+			node* _next{nullptr};
+			node* _prev{nullptr};
+			heap* _heap{nullptr};
+
+		public:
+			node() = default;
+
+			node(const node& that) = delete;
+
+			node(node&& that) = delete;
+
+			/**
+			 * Detach this node on destructor.
+			 */
+			virtual ~node();
+
+			/**
+			 * Removes the node from its heap (if any).
+			 * O(log n) amortized.
+			 */
+			void detach();
+
+			/**
+			 * @return true if the node is on a heap.
+			 */
+			[[nodiscard]] inline bool linked() const { return _heap != nullptr; }
+
+			/**
+			 * @return the heap the node is on, nullptr if it's on none.
+			 */
+			[[nodiscard]] inline heap* owner() const { return _heap; }
+
+			/**
+			 * @return the first child, nullptr if there's none.
+			 */
+			[[nodiscard]] inline const node* child() const { return _child; }
+
+			/**
+			 * @return the next sibling, nullptr if there's none.
+			 */
+			[[nodiscard]] inline const node* next() const { return _next; }
+
+			/**
+			 * @return the previous sibling (the parent, for a first
+			 *         child), nullptr for the root.
+			 */
+			[[nodiscard]] inline const node* prev() const { return _prev; }
+
+		};
+
+	}
+
+}
+
+#endif //O1CPPLIB_O1_PAIRING_NODE_HH
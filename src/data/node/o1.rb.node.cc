@@ -0,0 +1,85 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#include "o1.rb.node.hh"
+#include "../tree/o1.rb.tree.hh"
+
+using node = o1::rb::node;
+
+node::~node() {
+	detach();
+}
+
+void node::detach() {
+	if (_tree != nullptr)
+		_tree->unlink(this);
+}
+
+node* node::next() {
+	node* x = this;
+	if (x->_right != nullptr) {
+		x = x->_right;
+		while (x->_left != nullptr)
+			x = x->_left;
+		return x;
+	}
+
+	node* y = x->_parent;
+	if (y == nullptr) // the header of an empty tree.
+		return x;
+	while (y->_parent != nullptr && x == y->_right) {
+		x = y;
+		y = y->_parent;
+	}
+	return y;
+}
+
+node* node::prev() {
+	node* x = this;
+	if (x->_left != nullptr) {
+		x = x->_left;
+		while (x->_right != nullptr)
+			x = x->_right;
+		return x;
+	}
+
+	node* y = x->_parent;
+	if (y == nullptr) // the header of an empty tree.
+		return x;
+	while (y->_parent != nullptr && x == y->_left) {
+		x = y;
+		y = y->_parent;
+	}
+	return y;
+}
@@ -0,0 +1,120 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#ifndef O1CPPLIB_O1_RB_NODE_HH
+#define O1CPPLIB_O1_RB_NODE_HH
+
+namespace o1 {
+
+	namespace rb {
+
+		class tree;
+
+		/**
+		 * Red-black tree node.
+		 *
+		 * The tree sentinel (its header) is the parent of the root, and
+		 * the only node w/out a parent once linked; it ends in-order
+		 * traversals both ways.
+		 *
+		 * A node detaches itself from its tree when destroyed.
+		 */
+		class node {
+			friend class tree;
+
+			node* _parent{nullptr};
+			node* _left{nullptr};
+			node* _right{nullptr};
+			tree* _tree{nullptr};
+			bool _red{false};
+
+		public:
+			node() = default;
+
+			node(const node& that) = delete;
+
+			node(node&& that) = delete;
+
+			/**
+			 * Detach this node on destructor.
+			 */
+			virtual ~node();
+
+			/**
+			 * Removes the node from its tree (if any).
+			 * O(log n).
+			 */
+			void detach();
+
+			/**
+			 * @return true if the node is on a tree.
+			 */
+			[[nodiscard]] inline bool linked() const { return _tree != nullptr; }
+
+			/**
+			 * @return the tree the node is on, nullptr if it's on none.
+			 */
+			[[nodiscard]] inline tree* owner() const { return _tree; }
+
+			[[nodiscard]] inline const node* parent() const { return _parent; }
+
+			[[nodiscard]] inline const node* left() const { return _left; }
+
+			[[nodiscard]] inline const node* right() const { return _right; }
+
+			[[nodiscard]] inline bool red() const { return _red; }
+
+			/**
+			 * In-order successor.
+			 * @return the next node, the tree header after the last one.
+			 */
+			node* next();
+
+			[[nodiscard]] inline const node* next() const { return const_cast<node*>(this)->next(); }
+
+			/**
+			 * In-order predecessor.
+			 * @return the previous node, the tree header before the first one.
+			 */
+			node* prev();
+
+			[[nodiscard]] inline const node* prev() const { return const_cast<node*>(this)->prev(); }
+
+		};
+
+	}
+
+}
+
+#endif //O1CPPLIB_O1_RB_NODE_HH
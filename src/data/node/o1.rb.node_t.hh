@@ -0,0 +1,69 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#ifndef O1CPPLIB_O1_RB_NODE_T_HH
+#define O1CPPLIB_O1_RB_NODE_T_HH
+
+#include "./o1.node_t.hh"
+#include "./o1.rb.node.hh"
+
+namespace o1 {
+
+	namespace rb {
+
+		/**
+		 * Typed red-black tree node, holding a pointer to the datum (T).
+		 */
+		template <typename T>
+		class node_t: public o1::node_t<T>, public o1::rb::node {
+		public:
+			node_t() = delete;
+			explicit node_t(T* ref): o1::node_t<T>(ref) { }
+			~node_t() override = default;
+
+			/**
+			 * Given the datum object, return the o1::rb::node_t<T>.
+			 */
+			using getNodeFn = node_t<T>* (*)(T* obj);
+
+		};
+
+	}
+
+	template <typename T>
+	using rb_node_t = o1::rb::node_t<T>;
+
+}
+
+#endif //O1CPPLIB_O1_RB_NODE_T_HH
@@ -39,8 +39,12 @@ namespace o1 {
 
 	namespace s_linked {
 
+		class list;
+
 		// TODO documentation
 		class node {
+			friend class list;
+
 			node* _next{nullptr};
 
 		public:
@@ -0,0 +1,165 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#ifndef O1CPPLIB_O1_SKIP_NODE_HH
+#define O1CPPLIB_O1_SKIP_NODE_HH
+
+#include <cstddef>
+
+namespace o1 {
+
+	namespace skip {
+
+		class list;
+
+		/**
+		 * Skip list node: a tower of (up to maxLevels) double links.
+		 *
+		 * Being double linked on every level, a node gets unlinked in
+		 * O(levels) (expected O(1)) w/out searching for it, and it
+		 * detaches itself from its list when destroyed.
+		 *
+		 * The links are stored by the derived class (see tower), which
+		 * decides how tall the node may get.
+		 */
+		class node {
+		public:
+			/**
+			 * With a 1/4 promotion rate, searches stay logarithmic up to
+			 * ~4^levels nodes: 16M for maxLevels.
+			 *
+			 * Each level costs 16 bytes per node, while towers are ~1.33
+			 * levels tall on average: nodes of lists known to be smaller
+			 * should be shorter (see node_t).
+			 */
+			static const constexpr unsigned maxLevels = 12;
+
+		protected:
+			struct link {
+				node* next;
+				node* prev;
+			};
+
+			/**
+			 * @param links storage for @param capacity levels.
+			 */
+			node(link* links, unsigned capacity);
+
+			/**
+			 * Makes every level of the node point to itself (the list
+			 * sentinel, when empty).
+			 */
+			void loop();
+
+		private:
+			friend class list;
+
+			list* _list{nullptr};
+			link* _links;
+			unsigned _levels{0};
+			unsigned _capacity;
+
+		public:
+			node(const node& that) = delete;
+
+			node(node&& that) = delete;
+
+			/**
+			 * Detach this node on destructor.
+			 */
+			virtual ~node();
+
+			/**
+			 * Removes the node from its list (if any).
+			 * O(levels), expected O(1).
+			 */
+			void detach();
+
+			/**
+			 * @return true if the node is on a list.
+			 */
+			[[nodiscard]] inline bool linked() const { return _list != nullptr; }
+
+			/**
+			 * @return the list the node is on, nullptr if it's on none.
+			 */
+			[[nodiscard]] inline list* owner() const { return _list; }
+
+			/**
+			 * @return the height of the tower, 0 if the node is not linked.
+			 */
+			[[nodiscard]] inline unsigned levels() const { return _levels; }
+
+			/**
+			 * @return the maximum height of the tower.
+			 */
+			[[nodiscard]] inline unsigned capacity() const { return _capacity; }
+
+			[[nodiscard]] inline const node* next(unsigned level = 0) const { return _links[level].next; }
+
+			inline node* next(unsigned level = 0) { return _links[level].next; }
+
+			[[nodiscard]] inline const node* prev(unsigned level = 0) const { return _links[level].prev; }
+
+			inline node* prev(unsigned level = 0) { return _links[level].prev; }
+
+		};
+
+		/**
+		 * Skip list node, with room for @tparam Levels levels.
+		 */
+		template <unsigned Levels>
+		class tower: public node {
+			static_assert(Levels > 0 && Levels <= node::maxLevels, "o1::skip::tower: bad number of levels");
+
+			link _tower[Levels];
+
+		public:
+			tower(): node(_tower, Levels) {
+				loop();
+			}
+
+			/**
+			 * Detaches while the links are still there.
+			 */
+			~tower() override {
+				detach();
+			}
+		};
+
+	}
+
+}
+
+#endif //O1CPPLIB_O1_SKIP_NODE_HH
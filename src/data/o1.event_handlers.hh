@@ -61,20 +61,20 @@ namespace o1 {
 
 		void
 		attaching(base_node_t* node) override {
-			attaching(dynamic_cast<derived_node_t*>(node));
+			attaching(static_cast<derived_node_t*>(node));
 		}
 
 		void attached(base_node_t* node) override {
-			attached(dynamic_cast<derived_node_t*>(node));
+			attached(static_cast<derived_node_t*>(node));
 		}
 
 		void
 		detaching(base_node_t* node) override {
-			detaching(dynamic_cast<derived_node_t*>(node));
+			detaching(static_cast<derived_node_t*>(node));
 		}
 
 		void detached(base_node_t* node) override {
-			detached(dynamic_cast<derived_node_t*>(node));
+			detached(static_cast<derived_node_t*>(node));
 		}
 	};
 
@@ -105,30 +105,30 @@ namespace o1 {
 		void
 		attaching(base_node_t* node, base_container_t* container) override {
 			attaching(
-				dynamic_cast<derived_node_t*>(node),
-				dynamic_cast<derived_container_t*>(container)
+				static_cast<derived_node_t*>(node),
+				static_cast<derived_container_t*>(container)
 			);
 		}
 
 		void attached(base_node_t* node, base_container_t* container) override {
 			attached(
-				dynamic_cast<derived_node_t*>(node),
-				dynamic_cast<derived_container_t*>(container)
+				static_cast<derived_node_t*>(node),
+				static_cast<derived_container_t*>(container)
 			);
 		}
 
 		void
 		detaching(base_node_t* node, base_container_t* container) override {
 			detaching(
-				dynamic_cast<derived_node_t*>(node),
-				dynamic_cast<derived_container_t*>(container)
+				static_cast<derived_node_t*>(node),
+				static_cast<derived_container_t*>(container)
 			);
 		}
 
 		void detached(base_node_t* node, base_container_t* container) override {
 			detached(
-				dynamic_cast<derived_node_t*>(node),
-				dynamic_cast<derived_container_t*>(container)
+				static_cast<derived_node_t*>(node),
+				static_cast<derived_container_t*>(container)
 			);
 		}
 	};
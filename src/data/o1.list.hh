@@ -38,5 +38,7 @@
 #include "list/o1.d_linked.list.hh"
 #include "list/o1.s_linked.list_t.hh"
 #include "list/o1.d_linked.list_t.hh"
+#include "list/o1.d_linked.hook_list.hh"
+#include "list/o1.skip.list_t.hh"
 
 #endif //O1CPPLIB_O1_LIST_HH
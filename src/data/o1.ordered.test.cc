@@ -0,0 +1,222 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <vector>
+#include "o1.ordered.test_fixture.hh"
+#include "list/o1.skip.list_t.hh"
+#include "tree/o1.rb.tree_t.hh"
+
+/**
+ * Behaviour shared by the ordered containers (rb tree, skip list);
+ * their own tests cover what's specific to each one.
+ */
+namespace {
+
+	using o1::test::ByKey;
+	using o1::test::keys;
+
+	template <typename T>
+	using skip_node = o1::skip::node_t<T>;
+
+	template <typename Container, typename Item>
+	struct ordered {
+		using container_t = Container;
+		using item_t = Item;
+	};
+
+	using rb_item = o1::test::item<o1::rb_node_t>;
+	using skip_item = o1::test::item<skip_node>;
+
+	template <typename T>
+	class o1_ordered: public testing::Test {
+	};
+
+	using containers = testing::Types<
+		ordered<o1::rb_tree<rb_item, ByKey>, rb_item>,
+		ordered<o1::skip_list<skip_item, ByKey>, skip_item>
+	>;
+
+	TYPED_TEST_SUITE(o1_ordered, containers);
+
+	TYPED_TEST(o1_ordered, Constructor) {
+		typename TypeParam::container_t container(TypeParam::item_t::getNode);
+		EXPECT_TRUE(container.empty());
+		EXPECT_EQ(container.size(), 0);
+		EXPECT_EQ(container.front(), nullptr);
+		EXPECT_EQ(container.back(), nullptr);
+		EXPECT_TRUE(container.begin() == container.end());
+		EXPECT_TRUE(std::prev(container.end()) == container.end());
+	}
+
+	TYPED_TEST(o1_ordered, InsertKeepsOrder) {
+		using Item = typename TypeParam::item_t;
+		typename TypeParam::container_t container(Item::getNode);
+		std::vector<Item> items(1000);
+		std::vector<int> expected;
+		std::mt19937 random(42);
+
+		for (auto& item: items) {
+			item.key = int(random() % 500);
+			expected.push_back(item.key);
+			container.insert(&item);
+		}
+
+		std::sort(expected.begin(), expected.end());
+		EXPECT_EQ(container.size(), items.size());
+		EXPECT_EQ(keys(container), expected);
+		EXPECT_EQ(container.front()->key, expected.front());
+		EXPECT_EQ(container.back()->key, expected.back());
+
+		std::vector<int> reversed;
+		for (auto i = container.rbegin(); i != container.rend(); ++i)
+			reversed.push_back(i->key);
+		EXPECT_EQ(reversed, std::vector<int>(expected.rbegin(), expected.rend()));
+	}
+
+	TYPED_TEST(o1_ordered, EqualKeysInInsertionOrder) {
+		using Item = typename TypeParam::item_t;
+		typename TypeParam::container_t container(Item::getNode);
+		Item a(1, 0), b(1, 1), c(1, 2), d(0, 3);
+		container.insert(&a);
+		container.insert(&b);
+		container.insert(&d);
+		container.insert(&c);
+
+		EXPECT_EQ(container.find(1), &a);
+		std::vector<int> seqs;
+		for (auto& item: container)
+			seqs.push_back(item.seq);
+		EXPECT_EQ(seqs, std::vector<int>({3, 0, 1, 2}));
+
+		Item e(1, 4);
+		EXPECT_FALSE(container.insert_unique(&e));
+		Item f(2, 5);
+		EXPECT_TRUE(container.insert_unique(&f));
+		EXPECT_EQ(container.back(), &f);
+	}
+
+	TYPED_TEST(o1_ordered, Bounds) {
+		using Item = typename TypeParam::item_t;
+		typename TypeParam::container_t container(Item::getNode);
+		std::vector<Item> items(10);
+		for (int i = 0; i < 10; ++i) {
+			items[i].key = 10 * i;
+			container.insert(&items[i]);
+		}
+
+		EXPECT_EQ(container.find(30), &items[3]);
+		EXPECT_EQ(container.find(35), nullptr);
+		EXPECT_TRUE(container.contains(90));
+		EXPECT_FALSE(container.contains(-1));
+
+		EXPECT_EQ(container.lower_bound(30).get(), &items[3]);
+		EXPECT_EQ(container.upper_bound(30).get(), &items[4]);
+		EXPECT_EQ(container.lower_bound(35).get(), &items[4]);
+		EXPECT_TRUE(container.lower_bound(91) == container.end());
+		EXPECT_EQ(container.lower_bound(-5).get(), &items[0]);
+
+		// range scan [20, 50).
+		std::vector<int> range;
+		for (auto i = container.lower_bound(20); i != container.lower_bound(50); ++i)
+			range.push_back(i->key);
+		EXPECT_EQ(range, std::vector<int>({20, 30, 40}));
+
+		std::vector<int> tail;
+		for (auto i = container.at(&items[7]); i != container.end(); ++i)
+			tail.push_back(i->key);
+		EXPECT_EQ(tail, std::vector<int>({70, 80, 90}));
+	}
+
+	TYPED_TEST(o1_ordered, DestroyedElementsDetach) {
+		using Item = typename TypeParam::item_t;
+		typename TypeParam::container_t container(Item::getNode);
+		Item a(1), c(3);
+		container.insert(&a);
+		container.insert(&c);
+		{
+			Item b(2);
+			container.insert(&b);
+			EXPECT_EQ(container.size(), 3);
+		}
+		EXPECT_EQ(container.size(), 2);
+		EXPECT_EQ(keys(container), std::vector<int>({1, 3}));
+		EXPECT_EQ(container.find(2), nullptr);
+	}
+
+	TYPED_TEST(o1_ordered, ElementsOutliveContainer) {
+		using Item = typename TypeParam::item_t;
+		std::vector<Item> items(20);
+		{
+			typename TypeParam::container_t container(Item::getNode);
+			for (int i = 0; i < 20; ++i) {
+				items[i].key = i;
+				container.insert(&items[i]);
+			}
+		}
+		for (auto& item: items)
+			EXPECT_FALSE(item.node.linked());
+
+		typename TypeParam::container_t container(Item::getNode);
+		container.insert(&items[3]);
+		EXPECT_EQ(container.front(), &items[3]);
+	}
+
+	TYPED_TEST(o1_ordered, Iterators) {
+		using Item = typename TypeParam::item_t;
+		using container_t = typename TypeParam::container_t;
+		container_t container(Item::getNode);
+		std::vector<Item> items(20);
+		for (int i = 0; i < 20; ++i) {
+			items[i].key = (i * 7) % 20;
+			container.insert(&items[i]);
+		}
+
+		const container_t& ccontainer = container;
+		EXPECT_TRUE(std::is_sorted(ccontainer.begin(), ccontainer.end(), ByKey()));
+		EXPECT_EQ(std::prev(ccontainer.end())->key, 19);
+		EXPECT_EQ(std::prev(container.end(), 3)->key, 17);
+		EXPECT_EQ(std::distance(container.rbegin(), container.rend()), 20);
+
+		for (auto i = container.begin(); i != container.end();)
+			i = i->key % 2 ? container.erase(i) : std::next(i);
+
+		EXPECT_EQ(keys(container), std::vector<int>({0, 2, 4, 6, 8, 10, 12, 14, 16, 18}));
+		EXPECT_EQ(container.size(), 10);
+	}
+
+}
@@ -0,0 +1,95 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#ifndef O1CPPLIB_O1_ORDERED_TEST_FIXTURE_HH
+#define O1CPPLIB_O1_ORDERED_TEST_FIXTURE_HH
+
+#include <vector>
+
+namespace o1 {
+
+	namespace test {
+
+		/**
+		 * int keyed element of the ordered containers tests (rb tree,
+		 * skip list, pairing heap), embedding a Node<item>.
+		 * @param seq tells apart elements with equal keys.
+		 */
+		template <template <typename> class Node>
+		struct item {
+			using node_t = Node<item>;
+
+			int key{};
+			int seq{};
+			node_t node;
+
+			item(): node(this) {}
+
+			explicit item(int _key, int _seq = 0): key(_key), seq(_seq), node(this) {}
+
+			static node_t* getNode(item* datum) {
+				return &datum->node;
+			}
+		};
+
+		/**
+		 * Orders items by key; items may be compared to plain keys too.
+		 */
+		struct ByKey {
+			template <typename Item>
+			bool operator()(const Item& left, const Item& right) const { return left.key < right.key; }
+
+			template <typename Item>
+			bool operator()(const Item& left, int right) const { return left.key < right; }
+
+			template <typename Item>
+			bool operator()(int left, const Item& right) const { return left < right.key; }
+		};
+
+		/**
+		 * @return the keys of @param container, in iteration order.
+		 */
+		template <typename Container>
+		std::vector<int> keys(Container& container) {
+			std::vector<int> ret;
+			for (auto i = container.begin(); i != container.end(); ++i)
+				ret.push_back(i->key);
+			return ret;
+		}
+
+	}
+
+}
+
+#endif //O1CPPLIB_O1_ORDERED_TEST_FIXTURE_HH
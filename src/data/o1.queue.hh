@@ -38,5 +38,6 @@
 #include "queue/o1.d_linked.queue.hh"
 #include "queue/o1.s_linked.queue_t.hh"
 #include "queue/o1.d_linked.queue_t.hh"
+#include "queue/o1.chunked.queue_t.hh"
 
 #endif //O1CPPLIB_QUEUE_HH
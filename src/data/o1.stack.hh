@@ -38,5 +38,6 @@
 #include "stack/o1.d_linked.stack.hh"
 #include "stack/o1.s_linked.stack_t.hh"
 #include "stack/o1.d_linked.stack_t.hh"
+#include "stack/o1.chunked.stack_t.hh"
 
 #endif //O1CPPLIB_STACK_HH
@@ -0,0 +1,236 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#ifndef O1CPPLIB_O1_CHUNKED_QUEUE_T_HH
+#define O1CPPLIB_O1_CHUNKED_QUEUE_T_HH
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include "../node/o1.chunked.block_t.hh"
+
+namespace o1 {
+
+	namespace chunked {
+
+		/**
+		 * FIFO of T pointers, stored in blocks of Items pointers: push,
+		 * pop & iteration walk memory sequentially, and T does not need
+		 * to embed a node.
+		 *
+		 * Elements are NOT owned: neither pop() nor the destructor delete
+		 * them (see clear()).
+		 */
+		template <typename T, size_t Items = 63>
+		class queue_t: public o1::chunked::blocks_t<T, Items> {
+		public:
+			using blocks = o1::chunked::blocks_t<T, Items>;
+			using block = typename blocks::block;
+
+		private:
+			block* _head{nullptr};
+			block* _tail{nullptr};
+			size_t _headIndex{0};
+			size_t _tailIndex{0};
+			size_t _size{0};
+
+		public:
+
+			class iterator {
+				const block* _block;
+				size_t _index;
+
+			public:
+				using iterator_category = std::forward_iterator_tag;
+				using value_type = T*;
+				using difference_type = std::ptrdiff_t;
+				using pointer = T* const*;
+				using reference = T* const&;
+
+				iterator(): _block(nullptr), _index(0) {}
+
+				iterator(const block* b, size_t index): _block(b), _index(index) {}
+
+				reference operator*() const { return _block->slots[_index]; }
+
+				// prefix
+				iterator& operator++() {
+					if (++_index == Items && _block->next != nullptr) {
+						_block = _block->next;
+						_index = 0;
+					}
+					return *this;
+				}
+
+				// postfix
+				iterator operator++(int) {
+					iterator ret(*this);
+					++*this;
+					return ret;
+				}
+
+				bool operator == (const iterator& that) const {
+					return _block == that._block && _index == that._index;
+				}
+
+				bool operator != (const iterator& that) const {
+					return !(*this == that);
+				}
+			};
+
+			queue_t() = default;
+
+			queue_t(const queue_t& that) = delete;
+
+			queue_t(queue_t&& that) noexcept:
+				blocks(std::move(that)),
+				_head(that._head),
+				_tail(that._tail),
+				_headIndex(that._headIndex),
+				_tailIndex(that._tailIndex),
+				_size(that._size) {
+				that._head = that._tail = nullptr;
+				that._headIndex = that._tailIndex = that._size = 0;
+			}
+
+			/**
+			 * Upon destruction, elements are NOT deleted.
+			 */
+			~queue_t() {
+				flush();
+				if (_head != nullptr)
+					delete _head;
+			}
+
+			[[nodiscard]] inline size_t size() const { return _size; }
+
+			[[nodiscard]] inline bool empty() const { return _size == 0; }
+
+			/**
+			 * Adds @param datum at the end of the queue.
+			 * O(1); takes a block every Items pushes.
+			 */
+			void push(T* datum) {
+				if (_tail == nullptr) {
+					_head = _tail = this->acquire();
+				} else if (_tailIndex == Items) {
+					_tail->next = this->acquire();
+					_tail = _tail->next;
+					_tailIndex = 0;
+				}
+
+				_tail->slots[_tailIndex++] = datum;
+				++_size;
+			}
+
+			/**
+			 * Removes the element at the head of the queue.
+			 * @return the removed element, nullptr if the queue is empty.
+			 */
+			T* pop() {
+				if (_size == 0)
+					return nullptr;
+
+				T* ret = _head->slots[_headIndex++];
+
+				if (--_size == 0) {
+					// keep (just) the last block.
+					_headIndex = _tailIndex = 0;
+				} else if (_headIndex == Items) {
+					block* next = _head->next;
+					this->release(_head);
+					_head = next;
+					_headIndex = 0;
+				}
+
+				return ret;
+			}
+
+			/**
+			 * @return the element at the head of the queue, nullptr if
+			 *         it's empty.
+			 */
+			[[nodiscard]] T* peek() const {
+				return _size == 0 ? nullptr : _head->slots[_headIndex];
+			}
+
+			/**
+			 * Removes all elements, NOT deleting them.
+			 * Blocks go to the free list.
+			 */
+			void flush() {
+				if (_head == nullptr)
+					return;
+
+				while (_head != _tail) {
+					block* next = _head->next;
+					this->release(_head);
+					_head = next;
+				}
+
+				_headIndex = _tailIndex = _size = 0;
+			}
+
+			/**
+			 * Removes all elements, deleting them.
+			 */
+			void clear() {
+				while (!empty())
+					delete pop();
+			}
+
+			/**
+			 * Head to tail.
+			 */
+			iterator begin() const {
+				return _size == 0 ? end() : iterator(_head, _headIndex);
+			}
+
+			iterator end() const {
+				return iterator(_tail, _tailIndex);
+			}
+
+		};
+
+	}
+
+	/**
+	 * FIFO of T pointers, see chunked::queue_t.
+	 */
+	template <typename T, size_t Items = 63>
+	using chunked_queue = o1::chunked::queue_t<T, Items>;
+
+}
+
+#endif //O1CPPLIB_O1_CHUNKED_QUEUE_T_HH
@@ -0,0 +1,163 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#include <gtest/gtest.h>
+#include <vector>
+#include "o1.chunked.queue_t.hh"
+
+namespace {
+
+	struct Item {
+		int value{};
+	};
+
+	// small blocks, to cross block boundaries often.
+	using queue = o1::chunked_queue<Item, 4>;
+
+	size_t busyBlocks() {
+		return queue::block::memoryPool().getMetrics().items.busy();
+	}
+
+	TEST(o1_chunked_queue, Constructor) {
+		queue queue;
+		EXPECT_TRUE(queue.empty());
+		EXPECT_EQ(queue.size(), 0);
+		EXPECT_EQ(queue.peek(), nullptr);
+		EXPECT_EQ(queue.pop(), nullptr);
+		EXPECT_TRUE(queue.begin() == queue.end());
+	}
+
+	TEST(o1_chunked_queue, PushPop) {
+		queue queue;
+		std::vector<Item> items(50);
+
+		for (int round = 0; round < 3; ++round) {
+			for (auto& item: items)
+				queue.push(&item);
+			EXPECT_EQ(queue.size(), items.size());
+			EXPECT_EQ(queue.peek(), &items[0]);
+
+			for (auto& item: items)
+				EXPECT_EQ(queue.pop(), &item);
+			EXPECT_TRUE(queue.empty());
+			EXPECT_EQ(queue.pop(), nullptr);
+		}
+	}
+
+	TEST(o1_chunked_queue, Interleaved) {
+		queue queue;
+		std::vector<Item> items(100);
+		size_t pushed = 0, popped = 0;
+
+		while (popped < items.size()) {
+			for (int i = 0; i < 3 && pushed < items.size(); ++i)
+				queue.push(&items[pushed++]);
+			EXPECT_EQ(queue.pop(), &items[popped++]);
+			EXPECT_EQ(queue.size(), pushed - popped);
+		}
+		EXPECT_TRUE(queue.empty());
+	}
+
+	TEST(o1_chunked_queue, Iteration) {
+		queue queue;
+		std::vector<Item> items(23);
+		for (auto& item: items)
+			queue.push(&item);
+		queue.pop();
+		queue.pop();
+
+		size_t index = 2;
+		for (auto item: queue)
+			EXPECT_EQ(item, &items[index++]);
+		EXPECT_EQ(index, items.size());
+
+		// a full last block.
+		queue.push(&items[0]);
+		index = 0;
+		for (auto i = queue.begin(); i != queue.end(); ++i)
+			++index;
+		EXPECT_EQ(index, queue.size());
+	}
+
+	TEST(o1_chunked_queue, BlocksGetRecycled) {
+		size_t before = busyBlocks();
+		{
+			queue queue;
+			std::vector<Item> items(40);
+			for (auto& item: items)
+				queue.push(&item);
+			EXPECT_EQ(busyBlocks(), before + 10);
+
+			while (!queue.empty())
+				queue.pop();
+			// one block kept, up to maxSpareBlocks on the free list.
+			EXPECT_EQ(queue.spare(), queue::maxSpareBlocks);
+			EXPECT_EQ(busyBlocks(), before + 1 + queue::maxSpareBlocks);
+
+			// refilling takes the spare blocks first.
+			for (int i = 0; i < 20; ++i)
+				queue.push(&items[i]);
+			EXPECT_EQ(queue.spare(), 0);
+			EXPECT_EQ(busyBlocks(), before + 5);
+
+			queue.flush();
+			EXPECT_TRUE(queue.empty());
+			queue.shrink();
+			EXPECT_EQ(busyBlocks(), before + 1);
+		}
+		EXPECT_EQ(busyBlocks(), before);
+	}
+
+	TEST(o1_chunked_queue, MoveConstructor) {
+		queue src;
+		std::vector<Item> items(10);
+		for (auto& item: items)
+			src.push(&item);
+
+		queue dst(std::move(src));
+		EXPECT_TRUE(src.empty()); // NOLINT(bugprone-use-after-move)
+		EXPECT_EQ(dst.size(), items.size());
+		for (auto& item: items)
+			EXPECT_EQ(dst.pop(), &item);
+	}
+
+	TEST(o1_chunked_queue, Clear) {
+		queue queue;
+		for (int i = 0; i < 10; ++i)
+			queue.push(new Item());
+		queue.clear();
+		EXPECT_TRUE(queue.empty());
+	}
+
+}
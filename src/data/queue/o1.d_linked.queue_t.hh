@@ -88,7 +88,7 @@ namespace o1 {
 			 */
 			T* pop() {
 				return queue_t::node::ref(
-					dynamic_cast<queue_t::node*>(
+					static_cast<queue_t::node*>(
 						d_linked::queue::pop()
 					)
 				);
@@ -100,7 +100,7 @@ namespace o1 {
 			 */
 			T* peek() {
 				return queue_t::node::ref(
-					dynamic_cast<queue_t::node*>(
+					static_cast<queue_t::node*>(
 						d_linked::queue::peek()
 					)
 				);
@@ -112,7 +112,7 @@ namespace o1 {
 			 */
 			const T* peek() const {
 				return queue_t::node::ref(
-					dynamic_cast<queue_t::node*>(
+					static_cast<const queue_t::node*>(
 						d_linked::queue::peek()
 					)
 				);
@@ -87,7 +87,7 @@ namespace o1 {
 			 */
 			T* pop() {
 				return queue_t::node::ref(
-					dynamic_cast<queue_t::node*>(
+					static_cast<queue_t::node*>(
 						s_linked::queue::pop()
 					)
 				);
@@ -99,7 +99,7 @@ namespace o1 {
 			 */
 			T* peek() {
 				return queue_t::node::ref(
-					dynamic_cast<queue_t::node*>(
+					static_cast<queue_t::node*>(
 						s_linked::queue::peek()
 					)
 				);
@@ -111,7 +111,7 @@ namespace o1 {
 			 */
 			const T* peek() const {
 				return queue_t::node::ref(
-					dynamic_cast<const queue_t::node*>(
+					static_cast<const queue_t::node*>(
 						const_cast<const s_linked::queue::node*>(
 							s_linked::queue::peek()
 						)
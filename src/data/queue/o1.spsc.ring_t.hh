@@ -0,0 +1,198 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#ifndef O1CPPLIB_O1_SPSC_RING_T_HH
+#define O1CPPLIB_O1_SPSC_RING_T_HH
+
+#include <atomic>
+#include <cstddef>
+#include "../../o1.logging.hh"
+
+namespace o1 {
+
+	namespace spsc {
+
+		/**
+		 * Bounded, lock-free, single producer single consumer ring of T
+		 * (stored by value).
+		 *
+		 * Exactly one thread may call push() & commit(), and exactly one
+		 * (possibly different) thread may call pop() & release().
+		 *
+		 * Producer & consumer indexes live in different cache lines, and
+		 * each side keeps a cached copy of the other side's index, so the
+		 * shared lines are only touched when the cached value runs out.
+		 *
+		 * Writes become visible to the consumer on commit(), and reads
+		 * free space for the producer on release(), so a batch of
+		 * operations costs a single atomic store on each side.
+		 */
+		template <typename T>
+		class ring_t {
+			static const constexpr size_t cacheLineSize = 64;
+
+			/**
+			 * Number of slots, always a power of 2.
+			 */
+			size_t _capacity;
+			size_t _mask;
+			T* _slots;
+
+			char _pad0[cacheLineSize];
+
+			// producer side
+			std::atomic<size_t> _tail{0};
+			size_t _pendingTail{0};
+			size_t _cachedHead{0};
+
+			char _pad1[cacheLineSize];
+
+			// consumer side
+			std::atomic<size_t> _head{0};
+			size_t _pendingHead{0};
+			size_t _cachedTail{0};
+
+			char _pad2[cacheLineSize];
+
+			static size_t roundUp(size_t n) {
+				size_t ret = 1;
+				while (ret < n)
+					ret <<= 1;
+				return ret;
+			}
+
+		public:
+			ring_t() = delete;
+
+			/**
+			 * @param capacity minimum number of elements the ring can hold,
+			 *                 rounded up to the next power of 2.
+			 */
+			explicit ring_t(size_t capacity):
+				_capacity(roundUp(capacity)),
+				_mask(_capacity - 1),
+				_slots(new T[_capacity]) {
+				o1::xassert(capacity > 0, "o1::spsc::ring_t: capacity must be positive");
+			}
+
+			ring_t(const ring_t& that) = delete;
+
+			ring_t(ring_t&& that) = delete;
+
+			~ring_t() {
+				delete[] _slots;
+			}
+
+			inline size_t capacity() const { return _capacity; }
+
+			/**
+			 * Producer side.
+			 * Stores @param value in the ring, not visible to the consumer
+			 * until commit() gets called.
+			 * @return false if the ring is full.
+			 */
+			bool push(const T& value) {
+				if (_pendingTail - _cachedHead == _capacity) {
+					_cachedHead = _head.load(std::memory_order_acquire);
+					if (_pendingTail - _cachedHead == _capacity)
+						return false;
+				}
+
+				_slots[_pendingTail & _mask] = value;
+				++_pendingTail;
+				return true;
+			}
+
+			/**
+			 * Producer side.
+			 * @return true if the next push() will not fail.
+			 */
+			bool writable() {
+				if (_pendingTail - _cachedHead == _capacity)
+					_cachedHead = _head.load(std::memory_order_acquire);
+				return _pendingTail - _cachedHead != _capacity;
+			}
+
+			/**
+			 * Producer side.
+			 * Publish all the values pushed so far.
+			 */
+			inline void commit() {
+				_tail.store(_pendingTail, std::memory_order_release);
+			}
+
+			/**
+			 * Consumer side.
+			 * Moves the head value into @param value.
+			 * The slot is not given back to the producer until release()
+			 * gets called.
+			 * @return false if the ring is empty.
+			 */
+			bool pop(T& value) {
+				if (_pendingHead == _cachedTail) {
+					_cachedTail = _tail.load(std::memory_order_acquire);
+					if (_pendingHead == _cachedTail)
+						return false;
+				}
+
+				value = _slots[_pendingHead & _mask];
+				++_pendingHead;
+				return true;
+			}
+
+			/**
+			 * Consumer side.
+			 * Give back all the slots popped so far to the producer.
+			 */
+			inline void release() {
+				_head.store(_pendingHead, std::memory_order_release);
+			}
+
+			/**
+			 * Consumer side.
+			 * @return true if there's nothing committed left to pop().
+			 */
+			bool empty() {
+				if (_pendingHead == _cachedTail)
+					_cachedTail = _tail.load(std::memory_order_acquire);
+				return _pendingHead == _cachedTail;
+			}
+
+		};
+
+	}
+
+}
+
+#endif //O1CPPLIB_O1_SPSC_RING_T_HH
@@ -0,0 +1,234 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#ifndef O1CPPLIB_O1_CHUNKED_STACK_T_HH
+#define O1CPPLIB_O1_CHUNKED_STACK_T_HH
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include "../node/o1.chunked.block_t.hh"
+
+namespace o1 {
+
+	namespace chunked {
+
+		/**
+		 * LIFO of T pointers, stored in blocks of Items pointers (the top
+		 * block links to the one below it): push, pop & iteration walk
+		 * memory sequentially, and T does not need to embed a node.
+		 *
+		 * Elements are NOT owned: neither pop() nor the destructor delete
+		 * them (see clear()).
+		 */
+		template <typename T, size_t Items = 63>
+		class stack_t: public o1::chunked::blocks_t<T, Items> {
+		public:
+			using blocks = o1::chunked::blocks_t<T, Items>;
+			using block = typename blocks::block;
+
+		private:
+			block* _top{nullptr};
+			/**
+			 * Number of elements on the _top block.
+			 */
+			size_t _topCount{0};
+			size_t _size{0};
+
+		public:
+
+			class iterator {
+				const block* _block;
+				size_t _count;
+
+			public:
+				using iterator_category = std::forward_iterator_tag;
+				using value_type = T*;
+				using difference_type = std::ptrdiff_t;
+				using pointer = T* const*;
+				using reference = T* const&;
+
+				iterator(): _block(nullptr), _count(0) {}
+
+				iterator(const block* b, size_t count): _block(b), _count(count) {}
+
+				reference operator*() const { return _block->slots[_count - 1]; }
+
+				// prefix
+				iterator& operator++() {
+					if (--_count == 0 && _block->next != nullptr) {
+						_block = _block->next;
+						_count = Items;
+					}
+					return *this;
+				}
+
+				// postfix
+				iterator operator++(int) {
+					iterator ret(*this);
+					++*this;
+					return ret;
+				}
+
+				bool operator == (const iterator& that) const {
+					return _count == that._count && (_count == 0 || _block == that._block);
+				}
+
+				bool operator != (const iterator& that) const {
+					return !(*this == that);
+				}
+			};
+
+			stack_t() = default;
+
+			stack_t(const stack_t& that) = delete;
+
+			stack_t(stack_t&& that) noexcept:
+				blocks(std::move(that)),
+				_top(that._top),
+				_topCount(that._topCount),
+				_size(that._size) {
+				that._top = nullptr;
+				that._topCount = that._size = 0;
+			}
+
+			/**
+			 * Upon destruction, elements are NOT deleted.
+			 */
+			~stack_t() {
+				flush();
+				if (_top != nullptr)
+					delete _top;
+			}
+
+			[[nodiscard]] inline size_t size() const { return _size; }
+
+			[[nodiscard]] inline bool empty() const { return _size == 0; }
+
+			/**
+			 * Adds @param datum on top of the stack.
+			 * O(1); takes a block every Items pushes.
+			 */
+			void push(T* datum) {
+				if (_top == nullptr) {
+					_top = this->acquire();
+				} else if (_topCount == Items) {
+					block* b = this->acquire();
+					b->next = _top;
+					_top = b;
+					_topCount = 0;
+				}
+
+				_top->slots[_topCount++] = datum;
+				++_size;
+			}
+
+			/**
+			 * Removes the element on top of the stack.
+			 * @return the removed element, nullptr if the stack is empty.
+			 */
+			T* pop() {
+				if (_size == 0)
+					return nullptr;
+
+				T* ret = _top->slots[--_topCount];
+				--_size;
+
+				if (_topCount == 0 && _top->next != nullptr) {
+					block* below = _top->next;
+					this->release(_top);
+					_top = below;
+					_topCount = Items;
+				}
+
+				return ret;
+			}
+
+			/**
+			 * @return the element on top of the stack, nullptr if it's
+			 *         empty.
+			 */
+			[[nodiscard]] T* peek() const {
+				return _size == 0 ? nullptr : _top->slots[_topCount - 1];
+			}
+
+			/**
+			 * Removes all elements, NOT deleting them.
+			 * Blocks go to the free list.
+			 */
+			void flush() {
+				if (_top == nullptr)
+					return;
+
+				while (_top->next != nullptr) {
+					block* below = _top->next;
+					this->release(_top);
+					_top = below;
+				}
+
+				_topCount = _size = 0;
+			}
+
+			/**
+			 * Removes all elements, deleting them.
+			 */
+			void clear() {
+				while (!empty())
+					delete pop();
+			}
+
+			/**
+			 * Top to bottom.
+			 */
+			iterator begin() const {
+				return iterator(_top, _topCount);
+			}
+
+			iterator end() const {
+				return iterator(nullptr, 0);
+			}
+
+		};
+
+	}
+
+	/**
+	 * LIFO of T pointers, see chunked::stack_t.
+	 */
+	template <typename T, size_t Items = 63>
+	using chunked_stack = o1::chunked::stack_t<T, Items>;
+
+}
+
+#endif //O1CPPLIB_O1_CHUNKED_STACK_T_HH
@@ -0,0 +1,147 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#include <gtest/gtest.h>
+#include <vector>
+#include "o1.chunked.stack_t.hh"
+
+namespace {
+
+	struct Item {
+		int value{};
+	};
+
+	// small blocks, to cross block boundaries often.
+	using stack = o1::chunked_stack<Item, 4>;
+
+	size_t busyBlocks() {
+		return stack::block::memoryPool().getMetrics().items.busy();
+	}
+
+	TEST(o1_chunked_stack, Constructor) {
+		stack stack;
+		EXPECT_TRUE(stack.empty());
+		EXPECT_EQ(stack.size(), 0);
+		EXPECT_EQ(stack.peek(), nullptr);
+		EXPECT_EQ(stack.pop(), nullptr);
+		EXPECT_TRUE(stack.begin() == stack.end());
+	}
+
+	TEST(o1_chunked_stack, PushPop) {
+		stack stack;
+		std::vector<Item> items(50);
+
+		for (int round = 0; round < 3; ++round) {
+			for (auto& item: items)
+				stack.push(&item);
+			EXPECT_EQ(stack.size(), items.size());
+			EXPECT_EQ(stack.peek(), &items.back());
+
+			for (size_t i = items.size(); i--;)
+				EXPECT_EQ(stack.pop(), &items[i]);
+			EXPECT_TRUE(stack.empty());
+			EXPECT_EQ(stack.pop(), nullptr);
+		}
+	}
+
+	TEST(o1_chunked_stack, PushPopOnBlockBoundary) {
+		stack stack;
+		Item items[5];
+		for (int i = 0; i < 4; ++i)
+			stack.push(&items[i]);
+
+		for (int i = 0; i < 10; ++i) {
+			stack.push(&items[4]);
+			EXPECT_EQ(stack.pop(), &items[4]);
+			EXPECT_EQ(stack.peek(), &items[3]);
+		}
+		EXPECT_EQ(stack.size(), 4);
+	}
+
+	TEST(o1_chunked_stack, Iteration) {
+		stack stack;
+		std::vector<Item> items(23);
+		for (auto& item: items)
+			stack.push(&item);
+
+		size_t index = items.size();
+		for (auto item: stack)
+			EXPECT_EQ(item, &items[--index]);
+		EXPECT_EQ(index, 0);
+
+		// a full top block.
+		stack.push(&items[0]);
+		index = 0;
+		for (auto i = stack.begin(); i != stack.end(); ++i)
+			++index;
+		EXPECT_EQ(index, stack.size());
+	}
+
+	TEST(o1_chunked_stack, BlocksGetRecycled) {
+		size_t before = busyBlocks();
+		{
+			stack stack;
+			std::vector<Item> items(40);
+			for (auto& item: items)
+				stack.push(&item);
+			EXPECT_EQ(busyBlocks(), before + 10);
+
+			while (!stack.empty())
+				stack.pop();
+			EXPECT_EQ(stack.spare(), stack::maxSpareBlocks);
+			EXPECT_EQ(busyBlocks(), before + 1 + stack::maxSpareBlocks);
+
+			for (int i = 0; i < 20; ++i)
+				stack.push(&items[i]);
+			EXPECT_EQ(stack.spare(), 0);
+			EXPECT_EQ(busyBlocks(), before + 5);
+
+			stack.flush();
+			stack.shrink();
+			EXPECT_EQ(busyBlocks(), before + 1);
+		}
+		EXPECT_EQ(busyBlocks(), before);
+	}
+
+	TEST(o1_chunked_stack, MoveConstructor) {
+		stack src;
+		Item item;
+		src.push(&item);
+
+		stack dst(std::move(src));
+		EXPECT_TRUE(src.empty()); // NOLINT(bugprone-use-after-move)
+		EXPECT_EQ(dst.pop(), &item);
+	}
+
+}
@@ -88,7 +88,7 @@ namespace o1 {
 			 */
 			T* pop() {
 				return stack_t::node::ref(
-					dynamic_cast<stack_t::node*>(
+					static_cast<stack_t::node*>(
 						d_linked::stack::pop()
 					)
 				);
@@ -100,7 +100,7 @@ namespace o1 {
 			 */
 			T* peek() {
 				return stack_t::node::ref(
-					dynamic_cast<stack_t::node*>(
+					static_cast<stack_t::node*>(
 						d_linked::stack::peek()
 					)
 				);
@@ -112,7 +112,7 @@ namespace o1 {
 			 */
 			const T* peek() const {
 				return stack_t::node::ref(
-					dynamic_cast<stack_t::node*>(
+					static_cast<const stack_t::node*>(
 						d_linked::stack::peek()
 					)
 				);
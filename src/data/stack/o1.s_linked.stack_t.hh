@@ -85,7 +85,7 @@ namespace o1 {
 			 */
 			T* pop() {
 				return stack_t::node::ref(
-					dynamic_cast<stack_t::node*>(
+					static_cast<stack_t::node*>(
 						s_linked::stack::pop()
 					)
 				);
@@ -97,7 +97,7 @@ namespace o1 {
 			 */
 			T* peek() {
 				return stack_t::node::ref(
-					dynamic_cast<stack_t::node*>(
+					static_cast<stack_t::node*>(
 						s_linked::stack::peek()
 					)
 				);
@@ -109,7 +109,7 @@ namespace o1 {
 			 */
 			const T* peek() const {
 				return stack_t::node::ref(
-					dynamic_cast<const stack_t::node*>(
+					static_cast<const stack_t::node*>(
 						const_cast<const s_linked::stack::node*>(
 							s_linked::stack::peek()
 						)
@@ -0,0 +1,293 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#include "o1.rb.tree.hh"
+#include "../../o1.logging.hh"
+
+using o1::rb::tree;
+using node = o1::rb::tree::node;
+
+static inline bool isRed(const node* n) {
+	return n != nullptr && n->red();
+}
+
+tree::~tree() {
+	flush();
+}
+
+void tree::flush() {
+	// right rotations flatten the tree into a (right) list, no stack needed.
+	node* x = root();
+	while (x != nullptr) {
+		node* l = x->_left;
+		if (l != nullptr) {
+			x->_left = l->_right;
+			l->_right = x;
+			x = l;
+			continue;
+		}
+
+		node* r = x->_right;
+		x->_parent = x->_right = nullptr;
+		x->_tree = nullptr;
+		x->_red = false;
+		x = r;
+	}
+
+	_header._left = nullptr;
+	_leftmost = _rightmost = &_header;
+	_size = 0;
+}
+
+void tree::rotateLeft(node* x) {
+	node* y = x->_right;
+	x->_right = y->_left;
+	if (y->_left != nullptr)
+		y->_left->_parent = x;
+	transplant(x, y);
+	y->_left = x;
+	x->_parent = y;
+}
+
+void tree::rotateRight(node* x) {
+	node* y = x->_left;
+	x->_left = y->_right;
+	if (y->_right != nullptr)
+		y->_right->_parent = x;
+	transplant(x, y);
+	y->_right = x;
+	x->_parent = y;
+}
+
+void tree::transplant(node* u, node* v) {
+	node* p = u->_parent;
+	if (p->_left == u)
+		p->_left = v;
+	else
+		p->_right = v;
+	if (v != nullptr)
+		v->_parent = p;
+}
+
+void tree::link(node* z, node* parent, bool left) {
+	o1::xassert(z->_tree == nullptr, "o1::rb::tree::link: node is already on a tree");
+
+	z->_parent = parent;
+	z->_left = z->_right = nullptr;
+	z->_red = true;
+	z->_tree = this;
+
+	if (left) {
+		parent->_left = z;
+		if (parent == _leftmost || parent == &_header)
+			_leftmost = z;
+		if (parent == &_header)
+			_rightmost = z;
+	} else {
+		parent->_right = z;
+		if (parent == _rightmost)
+			_rightmost = z;
+	}
+
+	++_size;
+	insertFixup(z);
+}
+
+void tree::insertFixup(node* z) {
+	while (z != root() && z->_parent->_red) {
+		node* p = z->_parent;
+		node* g = p->_parent;
+
+		if (p == g->_left) {
+			node* u = g->_right;
+			if (isRed(u)) {
+				p->_red = u->_red = false;
+				g->_red = true;
+				z = g;
+				continue;
+			}
+			if (z == p->_right) {
+				rotateLeft(p);
+				p = z;
+			}
+			p->_red = false;
+			g->_red = true;
+			rotateRight(g);
+			break;
+		} else {
+			node* u = g->_left;
+			if (isRed(u)) {
+				p->_red = u->_red = false;
+				g->_red = true;
+				z = g;
+				continue;
+			}
+			if (z == p->_left) {
+				rotateRight(p);
+				p = z;
+			}
+			p->_red = false;
+			g->_red = true;
+			rotateLeft(g);
+			break;
+		}
+	}
+
+	root()->_red = false;
+}
+
+void tree::unlink(node* z) {
+	if (z == _leftmost)
+		_leftmost = z->next();
+	if (z == _rightmost)
+		_rightmost = z->prev();
+
+	node* x;
+	node* xParent;
+	bool removedRed = z->_red;
+
+	if (z->_left == nullptr) {
+		x = z->_right;
+		xParent = z->_parent;
+		transplant(z, x);
+	} else if (z->_right == nullptr) {
+		x = z->_left;
+		xParent = z->_parent;
+		transplant(z, x);
+	} else {
+		// z gets replaced by its successor y (leftmost of its right subtree).
+		node* y = z->_right;
+		while (y->_left != nullptr)
+			y = y->_left;
+
+		removedRed = y->_red;
+		x = y->_right;
+
+		if (y->_parent == z) {
+			xParent = y;
+		} else {
+			xParent = y->_parent;
+			transplant(y, x);
+			y->_right = z->_right;
+			y->_right->_parent = y;
+		}
+
+		transplant(z, y);
+		y->_left = z->_left;
+		y->_left->_parent = y;
+		y->_red = z->_red;
+	}
+
+	if (!removedRed)
+		eraseFixup(x, xParent);
+
+	z->_parent = z->_left = z->_right = nullptr;
+	z->_tree = nullptr;
+	z->_red = false;
+	--_size;
+}
+
+void tree::eraseFixup(node* x, node* parent) {
+	while (x != root() && !isRed(x)) {
+		if (x == parent->_left) {
+			node* w = parent->_right;
+			if (isRed(w)) {
+				w->_red = false;
+				parent->_red = true;
+				rotateLeft(parent);
+				w = parent->_right;
+			}
+			if (!isRed(w->_left) && !isRed(w->_right)) {
+				w->_red = true;
+				x = parent;
+				parent = x->_parent;
+				continue;
+			}
+			if (!isRed(w->_right)) {
+				w->_left->_red = false;
+				w->_red = true;
+				rotateRight(w);
+				w = parent->_right;
+			}
+			w->_red = parent->_red;
+			parent->_red = false;
+			w->_right->_red = false;
+			rotateLeft(parent);
+		} else {
+			node* w = parent->_left;
+			if (isRed(w)) {
+				w->_red = false;
+				parent->_red = true;
+				rotateRight(parent);
+				w = parent->_left;
+			}
+			if (!isRed(w->_left) && !isRed(w->_right)) {
+				w->_red = true;
+				x = parent;
+				parent = x->_parent;
+				continue;
+			}
+			if (!isRed(w->_left)) {
+				w->_right->_red = false;
+				w->_red = true;
+				rotateLeft(w);
+				w = parent->_left;
+			}
+			w->_red = parent->_red;
+			parent->_red = false;
+			w->_left->_red = false;
+			rotateRight(parent);
+		}
+		x = root();
+	}
+
+	if (x != nullptr)
+		x->_red = false;
+}
+
+node* tree::pop_front() {
+	node* ret = _leftmost;
+	if (ret == &_header)
+		return nullptr;
+	unlink(ret);
+	return ret;
+}
+
+node* tree::pop_back() {
+	node* ret = _rightmost;
+	if (ret == &_header)
+		return nullptr;
+	unlink(ret);
+	return ret;
+}
@@ -0,0 +1,168 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#ifndef O1CPPLIB_O1_RB_TREE_HH
+#define O1CPPLIB_O1_RB_TREE_HH
+
+#include <cstddef>
+#include "../node/o1.rb.node.hh"
+
+namespace o1 {
+
+	namespace rb {
+
+		/**
+		 * Untyped part of a red-black tree (see tree_t): the header,
+		 * linking, unlinking and rebalancing of nodes.
+		 *
+		 * Ordering (hence searching) is left to the typed tree; this one
+		 * only links a node as a given child of a given parent.
+		 *
+		 * Nodes point to their tree, so trees can't be moved.
+		 */
+		class tree {
+		public:
+			using node = o1::rb::node;
+
+		private:
+			friend node;
+
+			/**
+			 * Sentinel: its left child is the root.
+			 */
+			node _header;
+			node* _leftmost{&_header};
+			node* _rightmost{&_header};
+			size_t _size{0};
+
+			void rotateLeft(node* x);
+
+			void rotateRight(node* x);
+
+			/**
+			 * Puts @param v in place of @param u (as a child of u's parent).
+			 */
+			void transplant(node* u, node* v);
+
+			void insertFixup(node* z);
+
+			void eraseFixup(node* x, node* parent);
+
+			/**
+			 * O(log n).
+			 */
+			void unlink(node* z);
+
+		protected:
+
+			/**
+			 * Links @param z as the @param left (or right) child of
+			 * @param parent, which must have no such child (the header,
+			 * as the left one, for an empty tree).
+			 * O(log n).
+			 */
+			void link(node* z, node* parent, bool left);
+
+			[[nodiscard]] inline node* root() { return _header._left; }
+
+			[[nodiscard]] inline const node* root() const { return _header._left; }
+
+			[[nodiscard]] inline node* header() { return &_header; }
+
+			static inline node* left(node* n) { return n->_left; }
+
+			static inline node* right(node* n) { return n->_right; }
+
+		public:
+			tree() = default;
+
+			tree(const tree& that) = delete;
+
+			tree(tree&& that) = delete;
+
+			/**
+			 * Upon destruction, nodes are NOT deleted, just unlinked.
+			 */
+			virtual ~tree();
+
+			/**
+			 * Remove all nodes from the tree, NOT deleting them.
+			 * O(n).
+			 */
+			void flush();
+
+			[[nodiscard]] inline size_t size() const { return _size; }
+
+			[[nodiscard]] inline bool empty() const { return _size == 0; }
+
+			/**
+			 * @return the first (smallest) node, or finish() if the tree is empty.
+			 */
+			[[nodiscard]] inline const node* start() const { return _leftmost; }
+
+			[[nodiscard]] inline node* start() { return _leftmost; }
+
+			/**
+			 * @return the last (greatest) node, or finish() if the tree is empty.
+			 */
+			[[nodiscard]] inline const node* r_start() const { return _rightmost; }
+
+			[[nodiscard]] inline node* r_start() { return _rightmost; }
+
+			/**
+			 * When a node equals to the returned value, traversal has ended.
+			 */
+			[[nodiscard]] inline const node* finish() const { return &_header; }
+
+			[[nodiscard]] inline node* finish() { return &_header; }
+
+			/**
+			 * Removes (and returns) the first node.
+			 * @return the removed node, nullptr if the tree is empty.
+			 */
+			node* pop_front();
+
+			/**
+			 * Removes (and returns) the last node.
+			 * @return the removed node, nullptr if the tree is empty.
+			 */
+			node* pop_back();
+
+		};
+
+	}
+
+}
+
+#endif //O1CPPLIB_O1_RB_TREE_HH
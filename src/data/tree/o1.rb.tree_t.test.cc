@@ -0,0 +1,191 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#include <gtest/gtest.h>
+#include <iterator>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "o1.rb.tree_t.hh"
+#include "../o1.ordered.test_fixture.hh"
+#include "../../memory/o1.memory.allocations.test.hh"
+
+namespace {
+
+	using Item = o1::test::item<o1::rb_node_t>;
+	using rb_tree = o1::rb_tree<Item, o1::test::ByKey>;
+	using o1::test::keys;
+
+	/**
+	 * @return the black height of @param node, -1 if the subtree
+	 *         breaks any red-black (or linking) rule.
+	 */
+	int blackHeight(const o1::rb::node* node) {
+		if (node == nullptr)
+			return 1;
+
+		for (auto child: { node->left(), node->right() }) {
+			if (child == nullptr)
+				continue;
+			if (child->parent() != node)
+				return -1;
+			if (node->red() && child->red())
+				return -1;
+		}
+
+		int left = blackHeight(node->left());
+		int right = blackHeight(node->right());
+		if (left < 0 || left != right)
+			return -1;
+
+		return left + (node->red() ? 0 : 1);
+	}
+
+	bool valid(rb_tree& tree) {
+		auto root = tree.finish()->left();
+		if (root != nullptr && root->red())
+			return false;
+		return blackHeight(root) > 0;
+	}
+
+	TEST(o1_rb_tree, InsertAndErase) {
+		rb_tree tree(Item::getNode);
+		std::vector<Item> items(2000);
+		std::vector<int> expected;
+		std::mt19937 random(7);
+
+		for (auto& item: items) {
+			item.key = int(random() % 1000);
+			expected.push_back(item.key);
+			tree.insert(&item);
+		}
+
+		std::sort(expected.begin(), expected.end());
+		EXPECT_TRUE(valid(tree));
+		EXPECT_EQ(tree.size(), items.size());
+		EXPECT_EQ(keys(tree), expected);
+		EXPECT_EQ(tree.front()->key, expected.front());
+		EXPECT_EQ(tree.back()->key, expected.back());
+
+		std::vector<size_t> order(items.size());
+		for (size_t i = 0; i < order.size(); ++i)
+			order[i] = i;
+		std::shuffle(order.begin(), order.end(), random);
+
+		for (size_t i = 0; i < order.size(); ++i) {
+			auto& item = items[order[i]];
+			tree.erase(&item);
+			EXPECT_FALSE(item.node.linked());
+			expected.erase(std::find(expected.begin(), expected.end(), item.key));
+
+			if (i % 100 == 0) {
+				ASSERT_TRUE(valid(tree)) << "i=" << i;
+				ASSERT_EQ(keys(tree), expected) << "i=" << i;
+			}
+		}
+
+		EXPECT_TRUE(tree.empty());
+		EXPECT_EQ(tree.begin(), tree.end());
+	}
+
+	TEST(o1_rb_tree, ReverseOrder) {
+		rb_tree tree(Item::getNode);
+		std::vector<Item> items(100);
+		for (int i = 0; i < 100; ++i) {
+			items[i].key = 99 - i;
+			tree.insert(&items[i]);
+		}
+
+		EXPECT_TRUE(valid(tree));
+		int expected = 99;
+		for (auto i = tree.rbegin(); i != tree.rend(); ++i)
+			EXPECT_EQ(i->key, expected--);
+		EXPECT_EQ(expected, -1);
+	}
+
+	TEST(o1_rb_tree, PopFrontBack) {
+		rb_tree tree(Item::getNode);
+		std::vector<Item> items(50);
+		for (int i = 0; i < 50; ++i) {
+			items[i].key = i;
+			tree.insert(&items[i]);
+		}
+
+		for (int i = 0; i < 25; ++i) {
+			EXPECT_EQ(tree.pop_front(), &items[i]);
+			EXPECT_EQ(tree.pop_back(), &items[49 - i]);
+			ASSERT_TRUE(valid(tree));
+		}
+		EXPECT_TRUE(tree.empty());
+		EXPECT_EQ(tree.pop_front(), nullptr);
+	}
+
+	TEST(o1_rb_tree, DetachKeepsBalance) {
+		rb_tree tree(Item::getNode);
+		std::vector<Item> items(500);
+		for (size_t i = 0; i < items.size(); ++i) {
+			items[i].key = int((i * 211) % items.size());
+			tree.insert(&items[i]);
+		}
+
+		// elements leaving on their own (as when destroyed).
+		for (size_t i = 0; i < items.size(); i += 3) {
+			items[i].node.detach();
+			ASSERT_TRUE(valid(tree)) << "i=" << i;
+		}
+
+		EXPECT_EQ(tree.size(), items.size() - (items.size() + 2) / 3);
+		EXPECT_TRUE(std::is_sorted(tree.begin(), tree.end(), o1::test::ByKey()));
+	}
+
+	TEST(o1_rb_tree, NoAllocations) {
+		std::vector<Item> items(100);
+		rb_tree tree(Item::getNode);
+
+		size_t before = o1::memory::test::allocations();
+
+		for (int i = 0; i < 100; ++i) {
+			items[i].key = (i * 37) % 100;
+			tree.insert(&items[i]);
+		}
+		for (int i = 0; i < 100; i += 3)
+			tree.erase(&items[i]);
+		tree.flush();
+
+		size_t after = o1::memory::test::allocations();
+
+		EXPECT_EQ(after, before);
+	}
+
+}
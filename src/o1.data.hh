@@ -34,8 +34,10 @@
 #ifndef O1CPPLIB_O1_DATA_HH
 #define O1CPPLIB_O1_DATA_HH
 
+#include "data/o1.heap.hh"
 #include "data/o1.list.hh"
 #include "data/o1.queue.hh"
 #include "data/o1.stack.hh"
+#include "data/o1.tree.hh"
 
 #endif //O1CPPLIB_O1_DATA_HH
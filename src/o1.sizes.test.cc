@@ -85,6 +85,7 @@ namespace {
 		SHOW(sizeof(o1::s_linked::list::node));
 		SHOW(sizeof(o1::d_linked::list));
 		SHOW(sizeof(o1::d_linked::list::node));
+		SHOW(sizeof(o1::d_linked::hook<>));
 		SHOW(sizeof(o1::s_linked::queue));
 		SHOW(sizeof(o1::s_linked::queue::node));
 		SHOW(sizeof(o1::d_linked::queue));
@@ -98,10 +99,19 @@ namespace {
 		SHOW(sizeof(o1::s_linked::list_t<C>::node));
 		SHOW(sizeof(o1::d_linked::list_t<C>));
 		SHOW(sizeof(o1::d_linked::list_t<C>::node));
+		SHOW(sizeof(o1::skip_list<C>));
+		SHOW(sizeof(o1::skip_list<C>::node_t));
+		SHOW(sizeof(o1::rb_tree<C>));
+		SHOW(sizeof(o1::rb_tree<C>::node_t));
+		SHOW(sizeof(o1::heap<C>));
+		SHOW(sizeof(o1::heap<C>::node_t));
 		SHOW(sizeof(o1::s_linked::queue_t<C>));
 		SHOW(sizeof(o1::s_linked::queue_t<C>::node));
 		SHOW(sizeof(o1::d_linked::queue_t<C>));
 		SHOW(sizeof(o1::d_linked::queue_t<C>::node));
+		SHOW(sizeof(o1::chunked_queue<C>));
+		SHOW(sizeof(o1::chunked_queue<C>::block));
+		SHOW(sizeof(o1::chunked_stack<C>));
 		SHOW(sizeof(o1::s_linked::stack_t<C>));
 		SHOW(sizeof(o1::s_linked::stack_t<C>::node));
 		SHOW(sizeof(o1::d_linked::stack_t<C>));
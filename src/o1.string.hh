@@ -38,5 +38,6 @@
 #include "./string/o1.string.format.hh"
 #include "./string/o1.string.parse.hh"
 #include "./string/o1.string.conversion.hh"
+#include "./string/o1.string.intern.hh"
 
 #endif //O1CPPLIB_O1_STRING_HH
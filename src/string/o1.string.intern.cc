@@ -0,0 +1,175 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#include <new>
+#include "o1.string.intern.hh"
+#include "../o1.logging.hh"
+
+using o1::intern;
+using o1::hash::hash_val;
+
+namespace {
+
+	/**
+	 * Read or write lock on a pthread_rwlock_t, released on destruction.
+	 */
+	class scoped_rwlock {
+		pthread_rwlock_t* _lock;
+	public:
+		scoped_rwlock(pthread_rwlock_t* lock, bool exclusive): _lock(lock) {
+			int err = exclusive ?
+				pthread_rwlock_wrlock(_lock) :
+				pthread_rwlock_rdlock(_lock);
+			o1::xassert(err == 0, "o1::intern: could not lock (%d)", err);
+		}
+
+		scoped_rwlock(const scoped_rwlock& that) = delete;
+
+		~scoped_rwlock() {
+			pthread_rwlock_unlock(_lock);
+		}
+	};
+
+}
+
+o1::hash::ops<intern::key_t, intern::entry> intern::_ops{
+	.hashValue = intern::hashFn,
+	.getKey = intern::getKey,
+	.getNode = intern::getNode,
+	.equal = intern::equalFn
+};
+
+hash_val intern::hashFn(const key_t& key) {
+	return key.hash;
+}
+
+const intern::key_t intern::getKey(const entry* value) {
+	return key_t{value->data(), value->length(), value->hash()};
+}
+
+o1::hash::node_t<intern::entry>* intern::getNode(entry* value) {
+	return &value->_node;
+}
+
+bool intern::equalFn(const key_t& left, const key_t& right) {
+	return
+		left.hash == right.hash &&
+		left.length == right.length &&
+		memcmp(left.data, right.data, left.length) == 0;
+}
+
+intern::intern() {
+	int err = pthread_rwlock_init(&_lock, nullptr);
+	o1::xassert(err == 0, "o1::intern: pthread_rwlock_init failed (%d)", err);
+}
+
+intern::~intern() {
+	_table.clear();
+
+	// entries only hold (already detached) hash nodes, so the arena
+	// memory can be released w/out running their destructors.
+	for (auto block: _blocks)
+		delete[] block;
+
+	pthread_rwlock_destroy(&_lock);
+}
+
+void* intern::allocate(size_t size) {
+	const size_t alignment = alignof(entry);
+	size = (size + alignment - 1) & ~(alignment - 1);
+
+	if (size > _available) {
+		size_t newBlockSize = size > blockSize ? size : blockSize;
+		auto block = new char[newBlockSize];
+		_blocks.push_back(block);
+		_bytes += newBlockSize;
+
+		if (size > blockSize) // keep using the current block.
+			return block;
+
+		_cursor = block;
+		_available = newBlockSize;
+	}
+
+	void* ret = _cursor;
+	_cursor += size;
+	_available -= size;
+	return ret;
+}
+
+const intern::entry* intern::lookup(const key_t& key) const {
+	return _table.peek(key);
+}
+
+intern::handle intern::get(const char* s, size_t length) {
+	key_t key{s, length, o1::hash::hashValue(s, length)};
+
+	{
+		scoped_rwlock lock(&_lock, false);
+		if (auto found = lookup(key))
+			return handle(found);
+	}
+
+	scoped_rwlock lock(&_lock, true);
+
+	// someone may have interned it while we were not holding the lock.
+	if (auto found = lookup(key))
+		return handle(found);
+
+	auto value = new (allocate(sizeof(entry) + length + 1)) entry(key.hash, length);
+	auto data = reinterpret_cast<char*>(value + 1);
+	memcpy(data, s, length);
+	data[length] = '\0';
+
+	bool inserted = _table.insert(value);
+	o1::xassert(inserted, "o1::intern: internal inconsistency");
+
+	return handle(value);
+}
+
+intern::handle intern::find(const char* s, size_t length) const {
+	key_t key{s, length, o1::hash::hashValue(s, length)};
+	scoped_rwlock lock(&_lock, false);
+	return handle(lookup(key));
+}
+
+size_t intern::size() const {
+	scoped_rwlock lock(&_lock, false);
+	return _table.size();
+}
+
+size_t intern::bytes() const {
+	scoped_rwlock lock(&_lock, false);
+	return _bytes;
+}
@@ -0,0 +1,226 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#ifndef O1CPPLIB_O1_STRING_INTERN_HH
+#define O1CPPLIB_O1_STRING_INTERN_HH
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <pthread.h>
+#include "../data/hash/o1.hash.table_t.hh"
+
+namespace o1 {
+
+	/**
+	 * String interning store.
+	 *
+	 * Each distinct string gets stored once, in an append-only arena, and
+	 * is represented by a handle: equal strings (interned in the same
+	 * store) get the same handle, so comparing them is a pointer compare,
+	 * and the hash value is computed once, when the string is interned.
+	 *
+	 * Interned strings are never released until the store is destroyed,
+	 * so handles remain valid for the whole life of the store.
+	 *
+	 * Lookups can be done concurrently from many threads; interning a new
+	 * string takes an exclusive lock.
+	 */
+	class intern {
+	public:
+
+		/**
+		 * Lookup key: the string plus its hash value.
+		 */
+		struct key_t {
+			const char* data;
+			size_t length;
+			o1::hash::hash_val hash;
+		};
+
+		/**
+		 * An interned string, as stored in the arena: it's followed by
+		 * the characters (and a '\0').
+		 */
+		class entry {
+			o1::hash::hash_val _hash;
+			size_t _length;
+			o1::hash::node_t<entry> _node{this};
+
+			friend class intern;
+
+		public:
+			entry(o1::hash::hash_val hash, size_t length):
+				_hash(hash),
+				_length(length) {
+			}
+
+			entry(const entry& that) = delete;
+
+			entry(entry&& that) = delete;
+
+			inline const char* data() const {
+				return reinterpret_cast<const char*>(this + 1);
+			}
+
+			inline size_t length() const { return _length; }
+
+			inline o1::hash::hash_val hash() const { return _hash; }
+		};
+
+		/**
+		 * Reference to an interned string.
+		 * A default constructed handle refers to no string at all.
+		 */
+		class handle {
+			const entry* _entry{nullptr};
+
+		public:
+			handle() = default;
+
+			explicit handle(const entry* e): _entry(e) { }
+
+			inline bool operator == (const handle& that) const {
+				return _entry == that._entry;
+			}
+
+			inline bool operator != (const handle& that) const {
+				return _entry != that._entry;
+			}
+
+			inline explicit operator bool() const { return _entry != nullptr; }
+
+			inline const entry* get() const { return _entry; }
+
+			/**
+			 * @return the '\0' terminated string, nullptr for a null handle.
+			 */
+			inline const char* c_str() const {
+				return _entry == nullptr ? nullptr : _entry->data();
+			}
+
+			inline size_t length() const {
+				return _entry == nullptr ? 0 : _entry->length();
+			}
+
+			/**
+			 * @return the hash value computed when the string got interned.
+			 */
+			inline o1::hash::hash_val hash() const {
+				return _entry == nullptr ? 0 : _entry->hash();
+			}
+
+			inline std::string str() const {
+				return _entry == nullptr ?
+					std::string() :
+					std::string(_entry->data(), _entry->length());
+			}
+		};
+
+	private:
+
+		static o1::hash::hash_val hashFn(const key_t& key);
+		static const key_t getKey(const entry* value);
+		static o1::hash::node_t<entry>* getNode(entry* value);
+		static bool equalFn(const key_t& left, const key_t& right);
+
+		static o1::hash::ops<key_t, entry> _ops;
+
+		using table_t = o1::hash::table<key_t, entry, &intern::_ops>;
+
+		/**
+		 * Arena block size; longer strings get a block on their own.
+		 */
+		static const constexpr size_t blockSize = 65536;
+
+		table_t _table;
+		std::vector<char*> _blocks;
+		char* _cursor{nullptr};
+		size_t _available{0};
+		size_t _bytes{0};
+		mutable pthread_rwlock_t _lock;
+
+		void* allocate(size_t size);
+
+		const entry* lookup(const key_t& key) const;
+
+	public:
+
+		intern();
+
+		intern(const intern& that) = delete;
+
+		intern(intern&& that) = delete;
+
+		/**
+		 * All the handles get invalidated.
+		 */
+		~intern();
+
+		/**
+		 * @return the handle of the string, interning it if it's not
+		 *         already in the store.
+		 */
+		handle get(const char* s, size_t length);
+
+		inline handle get(const char* s) { return get(s, strlen(s)); }
+
+		inline handle get(const std::string& s) { return get(s.data(), s.length()); }
+
+		/**
+		 * @return the handle of the string, or a null handle if it was
+		 *         never interned.
+		 */
+		handle find(const char* s, size_t length) const;
+
+		inline handle find(const char* s) const { return find(s, strlen(s)); }
+
+		inline handle find(const std::string& s) const { return find(s.data(), s.length()); }
+
+		/**
+		 * @return number of distinct strings interned.
+		 */
+		size_t size() const;
+
+		/**
+		 * @return bytes allocated by the arena.
+		 */
+		size_t bytes() const;
+
+	};
+
+}
+
+#endif //O1CPPLIB_O1_STRING_INTERN_HH
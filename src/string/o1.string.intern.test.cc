@@ -0,0 +1,130 @@
+/**
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2021, Gonzalo Arana
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "o1.string.intern.hh"
+
+namespace {
+
+	TEST(o1_intern, basic) {
+		o1::intern strings;
+		std::string a1("content-type");
+		std::string a2("content-type");
+
+		auto h1 = strings.get(a1);
+		auto h2 = strings.get(a2.c_str());
+		auto h3 = strings.get("content-length");
+
+		EXPECT_EQ(h1, h2);
+		EXPECT_NE(h1, h3);
+		EXPECT_EQ(h1.c_str(), h2.c_str());
+		EXPECT_NE(h1.c_str(), a1.c_str());
+		EXPECT_EQ(h1.str(), a1);
+		EXPECT_EQ(h1.length(), a1.length());
+		EXPECT_EQ(h1.hash(), o1::hash::hashValue(a1.data(), a1.length()));
+		EXPECT_EQ(strings.size(), 2);
+	}
+
+	TEST(o1_intern, find) {
+		o1::intern strings;
+
+		EXPECT_FALSE(strings.find("label"));
+		EXPECT_EQ(strings.find("label").c_str(), nullptr);
+
+		auto h = strings.get("label");
+		EXPECT_EQ(strings.find("label"), h);
+		EXPECT_FALSE(strings.find("labels"));
+		EXPECT_EQ(strings.size(), 1);
+	}
+
+	TEST(o1_intern, embedded_zeroes_and_empty) {
+		o1::intern strings;
+		const char buf[] = {'a', '\0', 'b'};
+
+		auto h1 = strings.get(buf, 3);
+		auto h2 = strings.get(buf, 1);
+		auto empty = strings.get("");
+
+		EXPECT_NE(h1, h2);
+		EXPECT_EQ(h1.length(), 3);
+		EXPECT_EQ(h2.str(), "a");
+		EXPECT_TRUE(empty);
+		EXPECT_EQ(empty.length(), 0);
+		EXPECT_STREQ(empty.c_str(), "");
+	}
+
+	TEST(o1_intern, long_strings) {
+		o1::intern strings;
+		std::string big(200000, 'x');
+
+		auto small = strings.get("small");
+		auto h1 = strings.get(big);
+		auto h2 = strings.get(big);
+		auto small1 = strings.get("small1");
+
+		EXPECT_EQ(h1, h2);
+		EXPECT_EQ(h1.str(), big);
+		EXPECT_EQ(small.str(), "small");
+		EXPECT_EQ(small1.str(), "small1");
+		EXPECT_GE(strings.bytes(), big.length());
+	}
+
+	TEST(o1_intern, concurrent) {
+		o1::intern strings;
+		const int numThreads = 4;
+		const int numStrings = 1000;
+		std::vector<std::vector<o1::intern::handle>> handles(numThreads);
+		std::vector<std::thread> threads;
+
+		for (int t = 0; t < numThreads; ++t) {
+			threads.emplace_back([&strings, &handles, t]() {
+				for (int i = 0; i < numStrings; ++i)
+					handles[t].push_back(strings.get("header-" + std::to_string(i)));
+			});
+		}
+
+		for (auto& thread: threads)
+			thread.join();
+
+		EXPECT_EQ(strings.size(), numStrings);
+
+		for (int t = 1; t < numThreads; ++t) {
+			for (int i = 0; i < numStrings; ++i)
+				EXPECT_EQ(handles[t][i], handles[0][i]) << "t=" << t << " i=" << i;
+		}
+	}
+
+}
@@ -34,6 +34,7 @@
 
 #include "o1.string.parse.hh"
 #include "../errors/o1.error.invalid-format.hh"
+#include <cstring>
 
 uint64_t o1::xstrtoull(const char* s, int base) {
 	char* end = nullptr;